@@ -0,0 +1,160 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <geometry/intersection/collision.hpp>
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/spline/hermite_curve.hpp>
+#include <vector>
+
+namespace
+{
+auto makePoint(const double x, const double y) -> geometry_msgs::msg::Point
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  return point;
+}
+
+auto makePose(const double x, const double y, const double yaw = 0.0) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position = makePoint(x, y);
+  pose.orientation.z = std::sin(yaw * 0.5);
+  pose.orientation.w = std::cos(yaw * 0.5);
+  return pose;
+}
+
+/// @note Wavy line of the given number of control points, 1 meter apart along x axis.
+auto makeSpline(const std::size_t number_of_control_points) -> math::geometry::CatmullRomSpline
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (std::size_t i = 0; i < number_of_control_points; ++i) {
+    control_points.push_back(makePoint(i, std::sin(i * 0.1) * 5.0));
+  }
+  return math::geometry::CatmullRomSpline(control_points);
+}
+
+auto makeCurve() -> math::geometry::HermiteCurve
+{
+  geometry_msgs::msg::Vector3 start_vector;
+  start_vector.x = 10.0;
+  geometry_msgs::msg::Vector3 goal_vector;
+  goal_vector.y = 10.0;
+  return math::geometry::HermiteCurve(
+    makePose(0.0, 0.0), makePose(10.0, 10.0, M_PI_2), start_vector, goal_vector);
+}
+
+auto makeBoundingBox() -> traffic_simulator_msgs::msg::BoundingBox
+{
+  traffic_simulator_msgs::msg::BoundingBox bounding_box;
+  bounding_box.center.x = 1.0;
+  bounding_box.dimensions.x = 4.0;
+  bounding_box.dimensions.y = 2.0;
+  bounding_box.dimensions.z = 1.5;
+  return bounding_box;
+}
+}  // namespace
+
+static void CatmullRomSplineConstruct(benchmark::State & state)
+{
+  std::vector<geometry_msgs::msg::Point> control_points;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    control_points.push_back(makePoint(i, std::sin(i * 0.1) * 5.0));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::geometry::CatmullRomSpline(control_points));
+  }
+}
+BENCHMARK(CatmullRomSplineConstruct)->Arg(10)->Arg(100)->Arg(1000);
+
+static void CatmullRomSplineGetPoint(benchmark::State & state)
+{
+  const auto spline = makeSpline(state.range(0));
+  double s = 0.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getPoint(s));
+    s = std::fmod(s + 0.7, spline.getLength());
+  }
+}
+BENCHMARK(CatmullRomSplineGetPoint)->Arg(10)->Arg(100)->Arg(1000);
+
+static void CatmullRomSplineGetSValue(benchmark::State & state)
+{
+  const auto spline = makeSpline(state.range(0));
+  /// @note The last curve is the worst case of searching curves in order.
+  const auto pose = spline.getPose(spline.getLength() - 0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getSValue(pose));
+  }
+}
+BENCHMARK(CatmullRomSplineGetSValue)->Arg(10)->Arg(100)->Arg(1000);
+
+static void CatmullRomSplineGetCollisionPointIn2D(benchmark::State & state)
+{
+  const auto spline = makeSpline(state.range(0));
+  const std::vector<geometry_msgs::msg::Point> polygon{
+    makePoint(state.range(0) - 3.0, -10.0), makePoint(state.range(0) - 2.0, -10.0),
+    makePoint(state.range(0) - 2.0, 10.0), makePoint(state.range(0) - 3.0, 10.0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getCollisionPointIn2D(polygon));
+  }
+}
+BENCHMARK(CatmullRomSplineGetCollisionPointIn2D)->Arg(10)->Arg(100)->Arg(1000);
+
+static void HermiteCurveGetSValue(benchmark::State & state)
+{
+  const auto curve = makeCurve();
+  const auto pose = curve.getPose(0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getSValue(pose));
+  }
+}
+BENCHMARK(HermiteCurveGetSValue);
+
+static void HermiteCurveGetMaximum2DCurvature(benchmark::State & state)
+{
+  const auto curve = makeCurve();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getMaximum2DCurvature());
+  }
+}
+BENCHMARK(HermiteCurveGetMaximum2DCurvature);
+
+static void HermiteCurveGetLength(benchmark::State & state)
+{
+  const auto curve = makeCurve();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(curve.getLength(state.range(0)));
+  }
+}
+BENCHMARK(HermiteCurveGetLength)->Arg(30)->Arg(100);
+
+static void CheckCollision2D(benchmark::State & state)
+{
+  const auto bounding_box = makeBoundingBox();
+  /// @note Arg(0) is a pair of overlapping boxes, Arg(1) is a pair of separate boxes.
+  const auto pose0 = makePose(0.0, 0.0);
+  const auto pose1 = state.range(0) == 0 ? makePose(2.0, 1.0, 0.3) : makePose(20.0, 1.0, 0.3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      math::geometry::checkCollision2D(pose0, bounding_box, pose1, bounding_box));
+  }
+}
+BENCHMARK(CheckCollision2D)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -35,7 +35,7 @@ public:
   explicit CatmullRomSpline(const std::vector<geometry_msgs::msg::Point> & control_points);
   auto getLength() const -> double override { return total_length_; }
   auto getMaximum2DCurvature() const -> double;
-  auto getPoint(const double s) const -> geometry_msgs::msg::Point;
+  auto getPoint(const double s) const -> geometry_msgs::msg::Point override;
   auto getPoint(const double s, const double offset) const -> geometry_msgs::msg::Point;
   auto getTangentVector(const double s) const -> geometry_msgs::msg::Vector3;
   auto getNormalVector(const double s) const -> geometry_msgs::msg::Vector3;
@@ -60,6 +60,15 @@ public:
     const bool search_backward = false) const -> std::optional<double> override;
   auto getPolygon(const double width, const size_t num_points = 30, const double z_offset = 0)
     -> std::vector<geometry_msgs::msg::Point>;
+  /**
+   * @brief Minimum and maximum corners of the 2D bounding box of each curve, which contains the
+   *        whole curve. A spline of two control points has the box of its line segment.
+   */
+  auto getCurveBoundingBoxes() const
+    -> const std::vector<std::pair<geometry_msgs::msg::Point, geometry_msgs::msg::Point>> &
+  {
+    return curve_bounding_boxes_;
+  }
   const std::vector<geometry_msgs::msg::Point> control_points;
 
 private:
@@ -69,12 +78,19 @@ private:
     const -> std::vector<geometry_msgs::msg::Point>;
   auto getSInSplineCurve(const size_t curve_index, const double s) const -> double;
   auto getCurveIndexAndS(const double s) const -> std::pair<size_t, double>;
+  auto isCurveWithinDistance2D(
+    const size_t curve_index, const geometry_msgs::msg::Point & point,
+    const double distance) const -> bool;
   auto checkConnection() const -> bool;
   auto equals(const geometry_msgs::msg::Point & p0, const geometry_msgs::msg::Point & p1) const
     -> bool;
   std::vector<LineSegment> line_segments_;
   std::vector<HermiteCurve> curves_;
   std::vector<double> length_list_;
+  /// @note Arc length from the start of the spline to the start of each curve.
+  std::vector<double> accumulated_length_list_;
+  std::vector<std::pair<geometry_msgs::msg::Point, geometry_msgs::msg::Point>>
+    curve_bounding_boxes_;
   std::vector<double> maximum_2d_curvatures_;
   double total_length_;
 };
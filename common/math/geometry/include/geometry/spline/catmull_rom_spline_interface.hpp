@@ -30,6 +30,7 @@ class CatmullRomSplineInterface
 {
 public:
   virtual double getLength() const = 0;
+  virtual geometry_msgs::msg::Point getPoint(const double s) const = 0;
   virtual std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon,
     const bool search_backward = false) const = 0;
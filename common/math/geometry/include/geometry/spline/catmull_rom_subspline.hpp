@@ -41,6 +41,8 @@ public:
 
   double getLength() const override;
 
+  geometry_msgs::msg::Point getPoint(const double s) const override;
+
   std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon,
     const bool search_backward = false) const override;
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <geometry/linear_algebra.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <iostream>
@@ -141,6 +142,15 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
     /// @note In this case, spline is interpreted as line segment.
     case 2:
       total_length_ = line_segments_[0].getLength();
+      [this](const auto & p0, const auto & p1) {
+        geometry_msgs::msg::Point min_corner;
+        min_corner.x = std::min(p0.x, p1.x);
+        min_corner.y = std::min(p0.y, p1.y);
+        geometry_msgs::msg::Point max_corner;
+        max_corner.x = std::max(p0.x, p1.x);
+        max_corner.y = std::max(p0.y, p1.y);
+        curve_bounding_boxes_.emplace_back(min_corner, max_corner);
+      }(control_points[0], control_points[1]);
       break;
     /// @note In this case, spline is interpreted as curve.
     default:
@@ -236,9 +246,30 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
         for (const auto & curve : curves_) {
           length_list_.emplace_back(curve.getLength());
           maximum_2d_curvatures_.emplace_back(curve.getMaximum2DCurvature());
+          /**
+           * @note The curve equals the cubic Bezier curve with control points P(0),
+           * P(0) + T(0) / 3, P(1) - T(1) / 3 and P(1), where T is the tangent vector, and lies
+           * inside their convex hull.
+           */
+          const auto p0 = curve.getPoint(0.0);
+          const auto p3 = curve.getPoint(1.0);
+          const auto t0 = curve.getTangentVector(0.0);
+          const auto t1 = curve.getTangentVector(1.0);
+          const auto [min_x, max_x] =
+            std::minmax({p0.x, p0.x + t0.x / 3.0, p3.x - t1.x / 3.0, p3.x});
+          const auto [min_y, max_y] =
+            std::minmax({p0.y, p0.y + t0.y / 3.0, p3.y - t1.y / 3.0, p3.y});
+          geometry_msgs::msg::Point min_corner;
+          min_corner.x = min_x;
+          min_corner.y = min_y;
+          geometry_msgs::msg::Point max_corner;
+          max_corner.x = max_x;
+          max_corner.y = max_y;
+          curve_bounding_boxes_.emplace_back(min_corner, max_corner);
         }
         total_length_ = 0;
         for (const auto & length : length_list_) {
+          accumulated_length_list_.emplace_back(total_length_);
           total_length_ = total_length_ + length;
         }
         checkConnection();
@@ -256,29 +287,40 @@ auto CatmullRomSpline::getCurveIndexAndS(const double s) const -> std::pair<size
     return std::make_pair(
       curves_.size() - 1, s - (total_length_ - curves_[curves_.size() - 1].getLength()));
   }
-  double current_s = 0;
-  for (size_t i = 0; i < curves_.size(); i++) {
-    double prev_s = current_s;
-    current_s = current_s + length_list_[i];
-    if (prev_s <= s && s < current_s) {
-      return std::make_pair(i, s - prev_s);
-    }
+  /// @note The last curve starting at or before s, which skips curves of zero length.
+  const auto next_curve = std::upper_bound(
+    accumulated_length_list_.begin(), accumulated_length_list_.end(), s);
+  if (next_curve == accumulated_length_list_.begin()) {
+    THROW_SIMULATION_ERROR("failed to calculate curve index");  // LCOV_EXCL_LINE
   }
-  THROW_SIMULATION_ERROR("failed to calculate curve index");  // LCOV_EXCL_LINE
+  const auto index = static_cast<size_t>(
+    std::distance(accumulated_length_list_.begin(), std::prev(next_curve)));
+  return std::make_pair(index, s - accumulated_length_list_[index]);
 }
 
 auto CatmullRomSpline::getSInSplineCurve(const size_t curve_index, const double s) const -> double
 {
-  size_t n = curves_.size();
-  double ret = 0;
-  for (size_t i = 0; i < n; i++) {
-    if (i == curve_index) {
-      return ret + s;
-    } else {
-      ret = ret + curves_[i].getLength();
-    }
+  if (curve_index >= accumulated_length_list_.size()) {
+    THROW_SEMANTIC_ERROR("curve index does not match");  // LCOV_EXCL_LINE
   }
-  THROW_SEMANTIC_ERROR("curve index does not match");  // LCOV_EXCL_LINE
+  return accumulated_length_list_[curve_index] + s;
+}
+
+/**
+ * @note HermiteCurve::getSValue only finds points within the threshold distance of the pose, so
+ * curves whose bounding box is farther than that can be skipped without evaluating them.
+ */
+auto CatmullRomSpline::isCurveWithinDistance2D(
+  const size_t curve_index, const geometry_msgs::msg::Point & point, const double distance) const
+  -> bool
+{
+  /// @note Margin for the tolerance of the root finding in HermiteCurve.
+  constexpr double margin = 1e-3;
+  const auto & [min_corner, max_corner] = curve_bounding_boxes_[curve_index];
+  return min_corner.x - distance - margin <= point.x and
+         point.x <= max_corner.x + distance + margin and
+         min_corner.y - distance - margin <= point.y and
+         point.y <= max_corner.y + distance + margin;
 }
 
 auto CatmullRomSpline::getCollisionPointsIn2D(
@@ -428,14 +470,13 @@ auto CatmullRomSpline::getSValue(
       }
       return line_segments_[0].getSValue(pose, threshold_distance, true);
     default:
-      double s = 0;
       for (size_t i = 0; i < curves_.size(); i++) {
-        auto s_value = curves_[i].getSValue(pose, threshold_distance, true);
-        if (s_value) {
-          s = s + s_value.value();
-          return s;
+        if (not isCurveWithinDistance2D(i, pose.position, threshold_distance)) {
+          continue;
+        }
+        if (auto s_value = curves_[i].getSValue(pose, threshold_distance, true)) {
+          return accumulated_length_list_[i] + s_value.value();
         }
-        s = s + curves_[i].getLength();
       }
       return std::nullopt;
   }
@@ -23,6 +23,11 @@ namespace geometry
 {
 double CatmullRomSubspline::getLength() const { return end_s_ - start_s_; }
 
+geometry_msgs::msg::Point CatmullRomSubspline::getPoint(const double s) const
+{
+  return spline_->getPoint(start_s_ + s);
+}
+
 std::optional<double> CatmullRomSubspline::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, const bool search_backward) const
 {
@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 
@@ -547,6 +549,53 @@ TEST(CatmullRomSpline, getSValue2)
   EXPECT_DOUBLE_EQ(result1.value(), 0.42440442127906564);
 }
 
+/// @note Round trip through the arc length table and the curve bounding boxes on a long spline.
+TEST(CatmullRomSpline, getSValueLongSpline)
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (int i = 0; i < 200; ++i) {
+    points.emplace_back(makePoint(i * 1.0, std::sin(i * 0.1) * 5.0));
+  }
+  const auto spline = math::geometry::CatmullRomSpline(points);
+  for (double s = 0.5; s < spline.getLength(); s += spline.getLength() / 97.0) {
+    const auto result = spline.getSValue(spline.getPose(s), 0.5);
+    EXPECT_TRUE(result);
+    EXPECT_NEAR(result.value(), s, 1e-3);
+  }
+  EXPECT_FALSE(spline.getSValue(makePose(100.0, 20.0), 3.0));
+}
+
+/// @note Every point of the spline has to be inside the bounding box of some curve.
+TEST(CatmullRomSpline, getCurveBoundingBoxes)
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (int i = 0; i < 50; ++i) {
+    points.emplace_back(makePoint(i * 1.0, std::sin(i * 0.5) * 5.0));
+  }
+  const auto spline = math::geometry::CatmullRomSpline(points);
+  const auto & boxes = spline.getCurveBoundingBoxes();
+  ASSERT_EQ(boxes.size(), points.size() - 1);
+  const auto contains = [](const auto & box, const auto & point) {
+    const auto & [min_corner, max_corner] = box;
+    return min_corner.x - EPS <= point.x and point.x <= max_corner.x + EPS and
+           min_corner.y - EPS <= point.y and point.y <= max_corner.y + EPS;
+  };
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    EXPECT_TRUE(contains(boxes[i], points[i]));
+    EXPECT_TRUE(contains(boxes[i], points[i + 1]));
+  }
+  for (double s = 0.0; s < spline.getLength(); s += spline.getLength() / 1000.0) {
+    const auto point = spline.getPoint(s);
+    EXPECT_TRUE(std::any_of(
+      boxes.begin(), boxes.end(), [&](const auto & box) { return contains(box, point); }));
+  }
+
+  const auto line = math::geometry::CatmullRomSpline({makePoint(1.0, 2.0), makePoint(-1.0, 4.0)});
+  ASSERT_EQ(line.getCurveBoundingBoxes().size(), static_cast<size_t>(1));
+  EXPECT_POINT_EQ(line.getCurveBoundingBoxes()[0].first, makePoint(-1.0, 2.0));
+  EXPECT_POINT_EQ(line.getCurveBoundingBoxes()[0].second, makePoint(1.0, 4.0));
+}
+
 TEST(CatmullRomSpline, getSValueEdge)
 {
   const math::geometry::CatmullRomSpline spline = makeCurve();
@@ -54,6 +54,16 @@ TEST(CatmullRomSubspline, getLength_zero)
   EXPECT_DOUBLE_EQ(spline1.getLength(), 0.0);
 }
 
+TEST(CatmullRomSubspline, getPoint)
+{
+  const auto spline_ptr = makeLine();
+
+  math::geometry::CatmullRomSubspline spline(
+    spline_ptr, std::hypot(0.5, 1.5), std::hypot(1.5, 4.5));
+  EXPECT_POINT_NEAR(spline.getPoint(0.0), makePoint(0.5, 1.5), EPS);
+  EXPECT_POINT_NEAR(spline.getPoint(std::hypot(1.0, 3.0)), makePoint(1.5, 4.5), EPS);
+}
+
 TEST(CatmullRomSubspline, getCollisionPointIn2D)
 {
   const auto spline_ptr = makeLine();
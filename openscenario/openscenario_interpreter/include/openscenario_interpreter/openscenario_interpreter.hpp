@@ -52,6 +52,10 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   const rclcpp_lifecycle::LifecyclePublisher<Context>::SharedPtr publisher_of_context;
 
+  bool delta_encoded_entity_status;
+
+  int entity_update_thread_count;
+
   double local_frame_rate;
 
   double local_real_time_factor;
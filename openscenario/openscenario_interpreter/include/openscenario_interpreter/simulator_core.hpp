@@ -333,7 +333,9 @@ public:
 
       if (controller.isAutoware()) {
         core->attachLidarSensor(
-          entity_ref, controller.properties.template get<Double>("pointcloudPublishingDelay"));
+          entity_ref, controller.properties.template get<Double>("pointcloudPublishingDelay"),
+          traffic_simulator::helper::LidarType::VLP16,
+          controller.properties.template get<Boolean>("pointcloudStaticEnvironment"));
 
         core->attachDetectionSensor([&]() {
           simulation_api_schema::DetectionSensorConfiguration configuration;
@@ -35,12 +35,16 @@ namespace openscenario_interpreter
 Interpreter::Interpreter(const rclcpp::NodeOptions & options)
 : rclcpp_lifecycle::LifecycleNode("openscenario_interpreter", options),
   publisher_of_context(create_publisher<Context>("context", rclcpp::QoS(1).transient_local())),
+  delta_encoded_entity_status(false),
+  entity_update_thread_count(1),
   local_frame_rate(30),
   local_real_time_factor(1.0),
   osc_path(""),
   output_directory("/tmp"),
   record(false)
 {
+  DECLARE_PARAMETER(delta_encoded_entity_status);
+  DECLARE_PARAMETER(entity_update_thread_count);
   DECLARE_PARAMETER(local_frame_rate);
   DECLARE_PARAMETER(local_real_time_factor);
   DECLARE_PARAMETER(osc_path);
@@ -68,6 +72,8 @@ auto Interpreter::makeCurrentConfiguration() const -> traffic_simulator::Configu
     logic_file.isDirectory() ? logic_file : logic_file.filepath.parent_path());
   {
     configuration.auto_sink = false;
+    configuration.delta_encoded_entity_status = delta_encoded_entity_status;
+    configuration.entity_update_thread_count = std::max(entity_update_thread_count, 1);
     configuration.scenario_path = osc_path;
 
     // XXX DIRTY HACK!!!
@@ -99,6 +105,8 @@ auto Interpreter::on_configure(const rclcpp_lifecycle::State &) -> Result
 
       std::this_thread::sleep_for(std::chrono::seconds(1));  // NOTE: Wait for parameters to be set.
 
+      GET_PARAMETER(delta_encoded_entity_status);
+      GET_PARAMETER(entity_update_thread_count);
       GET_PARAMETER(local_frame_rate);
       GET_PARAMETER(local_real_time_factor);
       GET_PARAMETER(osc_path);
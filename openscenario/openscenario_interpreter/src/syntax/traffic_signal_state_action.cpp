@@ -34,8 +34,7 @@ auto TrafficSignalStateAction::run() noexcept -> void {}
 auto TrafficSignalStateAction::start() const -> void
 {
   for (traffic_simulator::TrafficLight & traffic_light : getConventionalTrafficLights(id())) {
-    traffic_light.clear();
-    traffic_light.set(state);
+    traffic_light.assign(state);
   };
 }
 
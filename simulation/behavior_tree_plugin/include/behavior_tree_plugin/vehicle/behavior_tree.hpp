@@ -17,6 +17,7 @@
 
 #include <behaviortree_cpp_v3/bt_factory.h>
 #include <behaviortree_cpp_v3/loggers/bt_cout_logger.h>
+#include <behaviortree_cpp_v3/xml_parsing.h>
 
 #include <behavior_tree_plugin/transition_events/transition_events.hpp>
 #include <functional>
@@ -80,8 +81,10 @@ public:
 
 private:
   BT::NodeStatus tickOnce(double current_time, double step_time);
-  auto createBehaviorTree(const std::string & format_path) -> BT::Tree;
-  BT::BehaviorTreeFactory factory_;
+  static auto getBehaviorTreeParser() -> BT::XMLParser &;
+  static auto createBehaviorTreeParser(
+    const BT::BehaviorTreeFactory &, const std::string & format_path)
+    -> std::unique_ptr<BT::XMLParser>;
   BT::Tree tree_;
   std::unique_ptr<behavior_tree_plugin::LoggingEvent> logging_event_ptr_;
   std::unique_ptr<behavior_tree_plugin::ResetRequestEvent> reset_request_event_ptr_;
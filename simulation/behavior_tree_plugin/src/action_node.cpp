@@ -234,21 +234,27 @@ auto ActionNode::getDistanceToFrontEntity(
 auto ActionNode::getFrontEntityName(const math::geometry::CatmullRomSplineInterface & spline) const
   -> std::optional<std::string>
 {
+  /**
+   * @note Only entities within 40 m of the beginning of the spline can collide with it before 40 m
+   * along it, so the other entities are skipped by the broadphase.
+   */
+  constexpr double max_distance = 40;
   std::vector<double> distances;
   std::vector<std::string> entities;
-  for (const auto & each : other_entity_status) {
-    const auto distance = getDistanceToTargetEntityPolygon(spline, each.first);
+  for (const auto & name :
+       other_entity_status.getEntityNamesInRange(spline.getPoint(0.0), max_distance)) {
+    const auto distance = getDistanceToTargetEntityPolygon(spline, name);
     const auto quat = quaternion_operation::getRotation(
       entity_status->getMapPose().orientation,
-      other_entity_status.at(each.first).getMapPose().orientation);
+      other_entity_status.at(name).getMapPose().orientation);
     /**
      * @note hard-coded parameter, if the Yaw value of RPY is in ~1.5708 -> 1.5708, entity is a candidate of front entity.
      */
     if (
       std::fabs(quaternion_operation::convertQuaternionToEulerAngle(quat).z) <=
       boost::math::constants::half_pi<double>()) {
-      if (distance && distance.value() < 40) {
-        entities.emplace_back(each.first);
+      if (distance && distance.value() < max_distance) {
+        entities.emplace_back(name);
         distances.emplace_back(distance.value());
       }
     }
@@ -343,15 +349,9 @@ auto ActionNode::getConflictingEntityStatusOnCrossWalk(const lanelet::Ids & rout
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
+  for (const auto & name : other_entity_status.getEntityNamesOnLanelets(
+         hdmap_utils->getConflictingCrosswalkIds(route_lanelets))) {
+    conflicting_entity_status.emplace_back(other_entity_status.at(name));
   }
   return conflicting_entity_status;
 }
@@ -360,38 +360,20 @@ auto ActionNode::getConflictingEntityStatusOnLane(const lanelet::Ids & route_lan
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
+  for (const auto & name : other_entity_status.getEntityNamesOnLanelets(
+         hdmap_utils->getConflictingLaneIds(route_lanelets))) {
+    conflicting_entity_status.emplace_back(other_entity_status.at(name));
   }
   return conflicting_entity_status;
 }
 
 auto ActionNode::foundConflictingEntity(const lanelet::Ids & following_lanelets) const -> bool
 {
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(following_lanelets);
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-  }
-  return false;
+  const auto crosswalk_entity_names = other_entity_status.getEntityNamesOnLanelets(
+    hdmap_utils->getConflictingCrosswalkIds(following_lanelets));
+  const auto lane_entity_names = other_entity_status.getEntityNamesOnLanelets(
+    hdmap_utils->getConflictingLaneIds(following_lanelets));
+  return not crosswalk_entity_names.empty() or not lane_entity_names.empty();
 }
 
 auto ActionNode::calculateUpdatedEntityStatus(
@@ -26,14 +26,7 @@ namespace entity_behavior
 {
 void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  namespace pedestrian = entity_behavior::pedestrian;
-  factory_.registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
-  factory_.registerNodeType<pedestrian::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-
-  auto base_path = ament_index_cpp::get_package_share_directory("behavior_tree_plugin");
-  auto format_path = base_path + "/config/pedestrian_entity_behavior.xml";
-  tree_ = createBehaviorTree(format_path);
+  tree_ = getBehaviorTreeParser().instantiateTree(BT::Blackboard::create());
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
   reset_request_event_ptr_ = std::make_unique<behavior_tree_plugin::ResetRequestEvent>(
@@ -42,7 +35,30 @@ void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto PedestrianBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+auto PedestrianBehaviorTree::getBehaviorTreeParser() -> BT::XMLParser &
+{
+  /**
+   * @note The factory and the parsed behavior tree are shared by all pedestrians, so that spawning
+   *       a pedestrian only instantiates its own tree. Pedestrians are spawned one at a time.
+   */
+  static const auto factory = []() {
+    namespace pedestrian = entity_behavior::pedestrian;
+    auto factory = std::make_unique<BT::BehaviorTreeFactory>();
+    factory->registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
+    factory->registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
+    factory->registerNodeType<pedestrian::FollowPolylineTrajectoryAction>(
+      "FollowPolylineTrajectory");
+    return factory;
+  }();
+  static const auto parser = createBehaviorTreeParser(
+    *factory, ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
+                "/config/pedestrian_entity_behavior.xml");
+  return *parser;
+}
+
+auto PedestrianBehaviorTree::createBehaviorTreeParser(
+  const BT::BehaviorTreeFactory & factory, const std::string & format_path)
+  -> std::unique_ptr<BT::XMLParser>
 {
   auto xml_doc = pugi::xml_document();
   xml_doc.load_file(format_path.c_str());
@@ -66,8 +82,8 @@ auto PedestrianBehaviorTree::createBehaviorTree(const std::string & format_path)
     const BT::TreeNodeManifest & manifest_;
   };
 
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
+  for (const auto & [id, manifest] : factory.manifests()) {
+    if (factory.builtinNodes().count(id) == 0) {
       auto walker = XMLTreeWalker(manifest);
       xml_doc.traverse(walker);
     }
@@ -75,7 +91,9 @@ auto PedestrianBehaviorTree::createBehaviorTree(const std::string & format_path)
 
   auto xml_str = std::stringstream();
   xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+  auto parser = std::make_unique<BT::XMLParser>(factory);
+  parser->loadFromText(xml_str.str());
+  return parser;
 }
 
 const std::string & PedestrianBehaviorTree::getCurrentAction() const
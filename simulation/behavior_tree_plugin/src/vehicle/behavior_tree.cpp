@@ -25,6 +25,7 @@
 #include <behavior_tree_plugin/vehicle/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <behavior_tree_plugin/vehicle/lane_change_action.hpp>
 #include <iostream>
+#include <memory>
 #include <pugixml.hpp>
 #include <sstream>
 #include <string>
@@ -35,22 +36,7 @@ namespace entity_behavior
 {
 void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
-    "FollowFrontEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
-    "StopAtCrossingEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>("StopAtStopLine");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
-    "StopAtTrafficLight");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
-  factory_.registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-  factory_.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
-
-  tree_ = createBehaviorTree(
-    ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
-    "/config/vehicle_entity_behavior.xml");
+  tree_ = getBehaviorTreeParser().instantiateTree(BT::Blackboard::create());
 
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
@@ -62,7 +48,38 @@ void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+auto VehicleBehaviorTree::getBehaviorTreeParser() -> BT::XMLParser &
+{
+  /**
+   * @note The factory and the parsed behavior tree are shared by all vehicles, so that spawning a
+   *       vehicle only instantiates its own tree. Vehicles are spawned one at a time.
+   */
+  static const auto factory = []() {
+    auto factory = std::make_unique<BT::BehaviorTreeFactory>();
+    factory->registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
+    factory->registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
+      "FollowFrontEntity");
+    factory->registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
+      "StopAtCrossingEntity");
+    factory->registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>(
+      "StopAtStopLine");
+    factory->registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
+      "StopAtTrafficLight");
+    factory->registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
+    factory->registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
+    factory->registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
+    factory->registerNodeType<vehicle::LaneChangeAction>("LaneChange");
+    return factory;
+  }();
+  static const auto parser = createBehaviorTreeParser(
+    *factory, ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
+                "/config/vehicle_entity_behavior.xml");
+  return *parser;
+}
+
+auto VehicleBehaviorTree::createBehaviorTreeParser(
+  const BT::BehaviorTreeFactory & factory, const std::string & format_path)
+  -> std::unique_ptr<BT::XMLParser>
 {
   auto xml_doc = pugi::xml_document();
   xml_doc.load_file(format_path.c_str());
@@ -86,8 +103,8 @@ auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) ->
     const BT::TreeNodeManifest & manifest_;
   };
 
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
+  for (const auto & [id, manifest] : factory.manifests()) {
+    if (factory.builtinNodes().count(id) == 0) {
       auto walker = XMLTreeWalker(manifest);
       xml_doc.traverse(walker);
     }
@@ -95,7 +112,9 @@ auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) ->
 
   auto xml_str = std::stringstream();
   xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+  auto parser = std::make_unique<BT::XMLParser>(factory);
+  parser->loadFromText(xml_str.str());
+  return parser;
 }
 
 auto VehicleBehaviorTree::getBehaviorParameter() -> traffic_simulator_msgs::msg::BehaviorParameter
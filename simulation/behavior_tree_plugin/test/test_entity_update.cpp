@@ -0,0 +1,132 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <rclcpp/rclcpp.hpp>
+#include <string>
+#include <traffic_simulator/api/configuration.hpp>
+#include <traffic_simulator/entity/entity_manager.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <vector>
+
+using EntityStatuses = std::vector<traffic_simulator_msgs::msg::EntityStatus>;
+
+static auto getVehicleParameters() -> traffic_simulator_msgs::msg::VehicleParameters
+{
+  traffic_simulator_msgs::msg::VehicleParameters parameters;
+  parameters.name = "vehicle.volkswagen.t";
+  parameters.subtype.value = traffic_simulator_msgs::msg::EntitySubtype::CAR;
+  parameters.performance.max_speed = 69.444;
+  parameters.performance.max_acceleration = 200;
+  parameters.performance.max_deceleration = 10.0;
+  parameters.bounding_box.center.x = 1.5;
+  parameters.bounding_box.center.z = 0.9;
+  parameters.bounding_box.dimensions.x = 4.5;
+  parameters.bounding_box.dimensions.y = 2.1;
+  parameters.bounding_box.dimensions.z = 1.8;
+  parameters.axles.front_axle.max_steering = 0.5;
+  parameters.axles.front_axle.wheel_diameter = 0.6;
+  parameters.axles.front_axle.track_width = 1.8;
+  parameters.axles.front_axle.position_x = 3.1;
+  parameters.axles.front_axle.position_z = 0.3;
+  parameters.axles.rear_axle.wheel_diameter = 0.6;
+  parameters.axles.rear_axle.track_width = 1.8;
+  parameters.axles.rear_axle.position_z = 0.3;
+  return parameters;
+}
+
+/**
+ * @brief Run the same frames with the given number of entity update threads.
+ * @note Configuration requires a point cloud map next to the lanelet map, so the lanelet map of
+ *       traffic_simulator is copied into a temporary directory together with an empty one.
+ */
+static auto simulate(const std::size_t entity_update_thread_count) -> std::vector<EntityStatuses>
+{
+  const auto map_path =
+    boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(map_path);
+  boost::filesystem::copy_file(
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm",
+    map_path / "lanelet2_map.osm");
+  std::ofstream((map_path / "pointcloud_map.pcd").string());
+
+  auto configuration = traffic_simulator::Configuration(map_path);
+  configuration.entity_update_thread_count = entity_update_thread_count;
+
+  const auto node = std::make_shared<rclcpp::Node>(
+    "entity_update_" + std::to_string(entity_update_thread_count),
+    rclcpp::NodeOptions().parameter_overrides(
+      {{"origin_latitude", 35.61836750154}, {"origin_longitude", 139.78066608243}}));
+
+  traffic_simulator::entity::EntityManager entity_manager(node, configuration);
+
+  /// @note Faster vehicles behind slower ones, so that they have to react to each other.
+  const auto spawn = [&](const std::string & name, lanelet::Id lanelet_id, double s, double speed) {
+    entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+      name,
+      traffic_simulator::CanonicalizedLaneletPose(
+        traffic_simulator::helper::constructLaneletPose(lanelet_id, s, 0),
+        entity_manager.getHdmapUtils()),
+      getVehicleParameters(),
+      traffic_simulator::entity::VehicleEntity::BuiltinBehavior::defaultBehavior());
+    entity_manager.setLinearVelocity(name, speed);
+    entity_manager.requestSpeedChange(name, speed, true);
+  };
+  spawn("npc0", 34513, 0.0, 15.0);
+  spawn("npc1", 34513, 10.0, 10.0);
+  spawn("npc2", 34513, 20.0, 5.0);
+  spawn("npc3", 34684, 0.0, 12.0);
+  spawn("npc4", 34684, 15.0, 3.0);
+
+  entity_manager.startNpcLogic();
+
+  std::vector<EntityStatuses> frames;
+  for (int frame = 0; frame < 100; ++frame) {
+    entity_manager.update(frame * 0.05, 0.05);
+    auto statuses = entity_manager.getEntityStatuses();
+    std::sort(std::begin(statuses), std::end(statuses), [](const auto & a, const auto & b) {
+      return a.name < b.name;
+    });
+    frames.push_back(statuses);
+  }
+
+  boost::filesystem::remove_all(map_path);
+  return frames;
+}
+
+TEST(EntityManager, UpdateInParallel)
+{
+  const auto expected = simulate(1);
+  const auto actual = simulate(4);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t frame = 0; frame < expected.size(); ++frame) {
+    ASSERT_EQ(expected[frame].size(), actual[frame].size());
+    for (std::size_t index = 0; index < expected[frame].size(); ++index) {
+      EXPECT_TRUE(expected[frame][index] == actual[frame][index])
+        << "frame " << frame << ", entity " << expected[frame][index].name;
+    }
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
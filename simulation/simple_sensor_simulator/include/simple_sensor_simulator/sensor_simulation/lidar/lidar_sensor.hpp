@@ -18,6 +18,7 @@
 #include <simulation_api_schema.pb.h>
 
 #include <memory>
+#include <optional>
 #include <queue>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -34,24 +35,43 @@ protected:
 
   simulation_api_schema::LidarConfiguration configuration_;
 
-  Raycaster raycaster_;
+  /// @note Shared with the other lidar sensors whose scans are traced against the same scene.
+  const std::shared_ptr<Raycaster> raycaster_;
+
+  const std::vector<Eigen::Matrix3d> rotation_matrices_;
+
   std::vector<std::string> detected_objects_;
 
   explicit LidarSensorBase(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration)
-  : previous_simulation_time_(current_simulation_time), configuration_(configuration)
+    const simulation_api_schema::LidarConfiguration & configuration,
+    const std::shared_ptr<Raycaster> & raycaster)
+  : previous_simulation_time_(current_simulation_time),
+    configuration_(configuration),
+    raycaster_(raycaster),
+    rotation_matrices_(Raycaster::getRotationMatrices(configuration))
   {
   }
 
 public:
   virtual ~LidarSensorBase() = default;
 
+  /**
+   * @brief Start a scan if it is due at the time, and return the rays to trace for it.
+   * @note  The scans of all sensors sharing the raycaster are traced together, and the result is
+   *        handed back to update.
+   */
+  auto startScan(
+    const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &)
+    -> std::optional<Raycaster::Scan>;
+
   virtual auto update(
-    const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
+    const double current_simulation_time, std::optional<Raycaster::Result> &&,
     const rclcpp::Time & current_ros_time) -> void = 0;
 
   auto getDetectedObjects() const -> const std::vector<std::string> & { return detected_objects_; }
+
+  auto getRaycaster() const -> const std::shared_ptr<Raycaster> & { return raycaster_; }
 };
 
 template <typename T>
@@ -61,30 +81,25 @@ class LidarSensor : public LidarSensorBase
 
   std::queue<std::pair<sensor_msgs::msg::PointCloud2, double>> queue_pointcloud_;
 
-  auto raycast(const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-    -> T;
-
 public:
   explicit LidarSensor(
     const double current_simulation_time,
     const simulation_api_schema::LidarConfiguration & configuration,
-    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr)
-  : LidarSensorBase(current_simulation_time, configuration), publisher_ptr_(publisher_ptr)
+    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr,
+    const std::shared_ptr<Raycaster> & raycaster)
+  : LidarSensorBase(current_simulation_time, configuration, raycaster),
+    publisher_ptr_(publisher_ptr)
   {
-    raycaster_.setDirection(configuration);
   }
 
   auto update(
-    const double current_simulation_time,
-    const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-    const rclcpp::Time & current_ros_time) -> void override
+    const double current_simulation_time, std::optional<Raycaster::Result> && result,
+    const rclcpp::Time &) -> void override
   {
-    if (
-      current_simulation_time - previous_simulation_time_ - configuration_.scan_duration() >=
-      -0.002) {
-      previous_simulation_time_ = current_simulation_time;
+    if (result) {
+      detected_objects_ = std::move(result->detected_objects);
       queue_pointcloud_.push(
-        std::make_pair(raycast(status, current_ros_time), current_simulation_time));
+        std::make_pair(std::move(result->pointcloud), current_simulation_time));
     } else {
       detected_objects_.clear();
     }
@@ -98,16 +113,12 @@ public:
       publisher_ptr_->publish(pointcloud);
     }
   }
-
-private:
-  // Override
-  Raycaster raycaster_;
 };
 
-template <>
-auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-  -> sensor_msgs::msg::PointCloud2;
+/// @note Add the entities except the one the lidar sensors are attached to, as boxes.
+auto addEntities(
+  Raycaster &, const std::vector<traffic_simulator_msgs::EntityStatus> &,
+  const std::string & sensor_entity) -> void;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SENSOR_HPP_
@@ -16,17 +16,23 @@
 #define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__RAYCASTER_HPP_
 
 #include <embree4/rtcore.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <quaternion_operation/quaternion_operation.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
+#include <optional>
 #include <random>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
 #include <string>
+#include <thread>
+#include <traffic_simulator/utils/worker_pool.hpp>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -48,43 +54,114 @@ public:
     auto primitive_ptr = std::make_unique<T>(std::forward<Ts>(xs)...);
     primitive_ptrs_.emplace(name, std::move(primitive_ptr));
   }
-  const sensor_msgs::msg::PointCloud2 raycast(
-    const std::string & frame_id, const rclcpp::Time & stamp,
-    const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0);
-  const std::vector<std::string> & getDetectedObject() const;
-  void setDirection(
+  /// @brief Rays of a scan of a lidar, traced from the origin in the directions of the matrices.
+  struct Scan
+  {
+    geometry_msgs::msg::Pose origin;
+    const std::vector<Eigen::Matrix3d> * rotation_matrices;
+    double max_distance = 300;
+    double min_distance = 0;
+  };
+  struct Result
+  {
+    sensor_msgs::msg::PointCloud2 pointcloud;
+    std::vector<std::string> detected_objects;
+  };
+  /**
+   * @brief Trace the scans of several lidars against the scene in a single batched pass.
+   * @note  The primitives added since the last raycast are reflected in the scene once for all the
+   *        scans, and the tiles of all the scans share the worker pool.
+   */
+  std::vector<Result> raycast(
+    const std::string & frame_id, const rclcpp::Time & stamp, const std::vector<Scan> & scans);
+  /**
+   * @brief Add static geometry, which is built into its own BVH once and layered under entities.
+   * @note  Hits on the static geometry are in the pointcloud, but not in the detected objects.
+   *        Building the BVH of a whole map takes long, so other raycasters should share it.
+   */
+  void setStaticEnvironment(const primitives::Primitive & environment);
+  /**
+   * @brief Create an empty raycaster on the same device, which instances the BVH of the static
+   *        environment of this raycaster instead of building it again.
+   */
+  std::shared_ptr<Raycaster> shareStaticEnvironment() const;
+  static std::vector<Eigen::Matrix3d> getRotationMatrices(
     const simulation_api_schema::LidarConfiguration & configuration,
     double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI);
 
 private:
-  std::vector<geometry_msgs::msg::Quaternion> getDirections(
+  /// @note The device is retained, and released by the destructor as the one created by others.
+  explicit Raycaster(RTCDevice device);
+  /**
+   * @brief Entity in the persistent scene, as an instance of a prototype which holds its geometry.
+   * @note  The prototype is built once and reused while the shape of the entity does not change, so
+   *        each frame only updates the transform of the instance.
+   */
+  struct Instance
+  {
+    std::unique_ptr<primitives::Primitive> primitive;
+    RTCScene prototype;
+    RTCGeometry geometry;
+    unsigned int geometry_id;
+    std::array<float, 12> transform;
+  };
+  /// @note Reconcile the instances with the primitives added since the last raycast.
+  void updateScene();
+  void detachInstance(const Instance & instance);
+  /// @note Takes the ownership of the prototype.
+  void attachStaticEnvironment(RTCScene prototype, const std::array<float, 12> & transform);
+  static std::vector<geometry_msgs::msg::Quaternion> getDirections(
     const std::vector<double> & vertical_angles, double horizontal_angle_start,
     double horizontal_angle_end, double horizontal_resolution);
-  std::vector<geometry_msgs::msg::Quaternion> directions_;
-  double previous_horizontal_angle_start_;
-  double previous_horizontal_angle_end_;
-  double previous_horizontal_resolution_;
-  std::vector<double> previous_vertical_angles_;
   std::unordered_map<std::string, std::unique_ptr<primitives::Primitive>> primitive_ptrs_;
   RTCDevice device_;
   RTCScene scene_;
+  /// @note Number of rays traced at once, 16 or 8 if the CPU of the device supports the packets.
+  const std::size_t packet_width_;
   std::random_device seed_gen_;
   std::default_random_engine engine_;
-  std::vector<std::string> detected_objects_;
+  std::unordered_map<std::string, Instance> instances_;
+  std::optional<Instance> static_environment_;
+  /// @note Names of the instances, by their geometry ids in scene_.
   std::unordered_map<unsigned int, std::string> geometry_ids_;
-  std::vector<Eigen::Matrix3d> rotation_matrices_;
+
+  /// @note Rays are split into tiles of consecutive directions, which are the unit of work.
+  static constexpr std::size_t tile_size = 1024;
+
+  /// @note Layout of a point in the data of the pointcloud, as declared by the fields of it.
+  struct Point
+  {
+    float x;
+    float y;
+    float z;
+    float intensity;
+  };
+
+  /// @note Rays of a scan from begin to end, and their output, whose capacity is reused.
+  struct Tile
+  {
+    std::size_t scan;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t point_count;
+    std::vector<unsigned int> detected_ids;
+  };
+  std::vector<Tile> tiles_;
+
+  // Run as many threads as physical cores (which is usually /2 virtual threads)
+  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
+  // Threads are started once and wait for the next raycast, instead of being started every time
+  traffic_simulator::WorkerPool thread_pool_{std::max(1U, std::thread::hardware_concurrency() / 2)};
+
+  static std::size_t getPacketWidth(RTCDevice device);
 
   static void intersect(
-    int thread_id, int thread_count, RTCScene scene,
-    pcl::PointCloud<pcl::PointXYZI>::Ptr thread_cloud, geometry_msgs::msg::Pose origin,
-    std::reference_wrapper<std::set<unsigned int>> ref_thread_detected_ids, double max_distance,
-    double min_distance,
-    std::reference_wrapper<const std::vector<Eigen::Matrix3d>> ref_rotation_matrices)
+    std::size_t begin, std::size_t end, RTCScene scene, Tile & tile, std::uint8_t * data,
+    const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+    const std::vector<Eigen::Matrix3d> & rotation_matrices)
   {
-    auto & rotation_matrices = ref_rotation_matrices.get();
-    auto & thread_detected_ids = ref_thread_detected_ids.get();
     const auto orientation_matrix = quaternion_operation::getRotationMatrix(origin.orientation);
-    for (unsigned int i = thread_id; i < rotation_matrices.size(); i += thread_count) {
+    for (std::size_t i = begin; i < end; ++i) {
       RTCRayHit rayhit = {};
       rayhit.ray.org_x = origin.position.x;
       rayhit.ray.org_y = origin.position.y;
@@ -95,26 +172,83 @@ private:
       rayhit.ray.tnear = min_distance;
       rayhit.ray.flags = false;
 
-      const auto rotation_mat = orientation_matrix * rotation_matrices.at(i);
+      const auto rotation_mat = orientation_matrix * rotation_matrices[i];
       rayhit.ray.dir_x = rotation_mat(0);
       rayhit.ray.dir_y = rotation_mat(1);
       rayhit.ray.dir_z = rotation_mat(2);
       rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
       rtcIntersect1(scene, &rayhit);
 
       if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
-        double distance = rayhit.ray.tfar;
-        pcl::PointXYZI p;
-        {
-          p.x = rotation_matrices.at(i)(0) * distance;
-          p.y = rotation_matrices.at(i)(1) * distance;
-          p.z = rotation_matrices.at(i)(2) * distance;
+        addHit(tile, data, rotation_matrices[i], rayhit.ray.tfar, rayhit.hit.instID[0]);
+      }
+    }
+  }
+
+  /**
+   * @brief Trace rays in packets of N consecutive directions, which are coherent in a scan pattern.
+   * @note  The last packet of a tile is partially masked out by the valid array.
+   */
+  template <std::size_t N, typename RTCRayHitN, typename IntersectN>
+  static void intersectPackets(
+    std::size_t begin, std::size_t end, RTCScene scene, Tile & tile, std::uint8_t * data,
+    const geometry_msgs::msg::Pose & origin, double max_distance, double min_distance,
+    const std::vector<Eigen::Matrix3d> & rotation_matrices, IntersectN intersect_n)
+  {
+    const auto orientation_matrix = quaternion_operation::getRotationMatrix(origin.orientation);
+    for (std::size_t first = begin; first < end; first += N) {
+      alignas(64) int valid[N];
+      RTCRayHitN rayhit = {};
+      for (std::size_t j = 0; j < N; ++j) {
+        valid[j] = first + j < end ? -1 : 0;
+        if (valid[j]) {
+          rayhit.ray.org_x[j] = origin.position.x;
+          rayhit.ray.org_y[j] = origin.position.y;
+          rayhit.ray.org_z[j] = origin.position.z;
+          // make raycast interact with all objects
+          rayhit.ray.mask[j] = 0b11111111'11111111'11111111'11111111;
+          rayhit.ray.tfar[j] = max_distance;
+          rayhit.ray.tnear[j] = min_distance;
+          rayhit.ray.flags[j] = false;
+
+          const auto rotation_mat = orientation_matrix * rotation_matrices[first + j];
+          rayhit.ray.dir_x[j] = rotation_mat(0);
+          rayhit.ray.dir_y[j] = rotation_mat(1);
+          rayhit.ray.dir_z[j] = rotation_mat(2);
+          rayhit.hit.geomID[j] = RTC_INVALID_GEOMETRY_ID;
+          rayhit.hit.instID[0][j] = RTC_INVALID_GEOMETRY_ID;
+        }
+      }
+      intersect_n(valid, scene, &rayhit);
+
+      for (std::size_t j = 0; j < N; ++j) {
+        if (valid[j] and rayhit.hit.geomID[j] != RTC_INVALID_GEOMETRY_ID) {
+          addHit(
+            tile, data, rotation_matrices[first + j], rayhit.ray.tfar[j],
+            rayhit.hit.instID[0][j]);
         }
-        thread_cloud->emplace_back(p);
-        thread_detected_ids.insert(rayhit.hit.geomID);
       }
     }
   }
+
+  static void addHit(
+    Tile & tile, std::uint8_t * data, const Eigen::Matrix3d & rotation_matrix, double distance,
+    unsigned int instance_id)
+  {
+    Point p;
+    {
+      p.x = rotation_matrix(0) * distance;
+      p.y = rotation_matrix(1) * distance;
+      p.z = rotation_matrix(2) * distance;
+      p.intensity = 0;
+    }
+    std::memcpy(data + tile.point_count++ * sizeof(Point), &p, sizeof(Point));
+    // consecutive rays mostly hit the same object, so this keeps the ids short
+    if (tile.detected_ids.empty() or tile.detected_ids.back() != instance_id) {
+      tile.detected_ids.push_back(instance_id);
+    }
+  }
 };
 }  // namespace simple_sensor_simulator
 
@@ -18,6 +18,7 @@
 #include <embree4/rtcore.h>
 
 #include <algorithm>
+#include <array>
 #include <geometry/polygon/polygon.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <optional>
@@ -55,6 +56,17 @@ public:
   const std::string type;
   const geometry_msgs::msg::Pose pose;
   unsigned int addToScene(RTCDevice device, RTCScene scene);
+  /**
+   * @brief Create a committed scene which contains this primitive in its local coordinate, to be
+   *        instanced with the transform returned by getTransformMatrix.
+   * @note  The caller owns the returned scene and has to release it.
+   */
+  RTCScene createPrototype(
+    RTCDevice device, RTCBuildQuality build_quality = RTC_BUILD_QUALITY_MEDIUM) const;
+  /// @note 3x4 column-major matrix of the pose, in the layout of RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR.
+  std::array<float, 12> getTransformMatrix() const;
+  /// @note True if the prototypes of both primitives are the same, regardless of their poses.
+  bool hasSameShape(const Primitive & other) const;
   std::vector<Vertex> getVertex() const;
   std::vector<Triangle> getTriangles() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull() const;
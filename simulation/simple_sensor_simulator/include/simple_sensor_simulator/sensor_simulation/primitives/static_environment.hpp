@@ -0,0 +1,52 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__STATIC_ENVIRONMENT_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__STATIC_ENVIRONMENT_HPP_
+
+#include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/shared_map_image.hpp>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+/**
+ * @brief Triangle mesh of the static geometry of the lanelet map, in the map coordinate.
+ * @note  The road surface is triangulated between the bounds of each lanelet, and line strings of
+ *        curbs, guard rails, fences and walls are extruded upward to their typical heights.
+ */
+class StaticEnvironment : public Primitive
+{
+public:
+  /// @note Empty environment, to which surfaces and walls are added.
+  StaticEnvironment();
+  explicit StaticEnvironment(const hdmap_utils::HdMapUtils &);
+  /// @note Same environment as from HdMapUtils, built from the image without loading the map.
+  explicit StaticEnvironment(const hdmap_utils::SharedMapImage &);
+  ~StaticEnvironment() = default;
+
+  /// @note Strip of triangles between the bounds, ignored if either of them has less than 2 points.
+  void addSurface(
+    const std::vector<geometry_msgs::msg::Point> & left_bound,
+    const std::vector<geometry_msgs::msg::Point> & right_bound);
+  /// @note 2 triangles per segment of the line string, extruded upward by the height.
+  void addWall(const std::vector<geometry_msgs::msg::Point> & line_string, double height);
+};
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__STATIC_ENVIRONMENT_HPP_
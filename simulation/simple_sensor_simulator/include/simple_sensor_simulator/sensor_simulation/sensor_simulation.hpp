@@ -21,13 +21,18 @@
 #include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/traffic_signal_array.hpp>
 #include <autoware_perception_msgs/msg/traffic_signal_array.hpp>
+#include <algorithm>
+#include <functional>
 #include <iomanip>
+#include <iterator>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/static_environment.hpp>
 #include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_lights_detector.hpp>
+#include <string>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -37,13 +42,40 @@ class SensorSimulation
 public:
   auto attachLidarSensor(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node) -> void
+    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node,
+    const std::function<primitives::StaticEnvironment()> & make_static_environment) -> void
   {
     if (configuration.architecture_type().find("awf/universe") != std::string::npos) {
+      auto raycaster = std::find_if(
+        lidar_raycasters_.begin(), lidar_raycasters_.end(), [&](const auto & lidar_raycaster) {
+          return lidar_raycaster.entity == configuration.entity() and
+                 lidar_raycaster.static_environment == configuration.static_environment();
+        });
+      if (raycaster == lidar_raycasters_.end()) {
+        const auto make_raycaster = [&]() {
+          if (not configuration.static_environment()) {
+            return std::make_shared<Raycaster>();
+          } else if (const auto other = std::find_if(
+                       lidar_raycasters_.begin(), lidar_raycasters_.end(),
+                       [](const auto & each) { return each.static_environment; });
+                     other != lidar_raycasters_.end()) {
+            /// @note The BVH of the static environment is built only for the first raycaster.
+            return other->raycaster->shareStaticEnvironment();
+          } else {
+            auto first = std::make_shared<Raycaster>();
+            first->setStaticEnvironment(make_static_environment());
+            return first;
+          }
+        };
+        lidar_raycasters_.push_back(
+          {configuration.entity(), configuration.static_environment(), make_raycaster()});
+        raycaster = std::prev(lidar_raycasters_.end());
+      }
       lidar_sensors_.push_back(std::make_unique<LidarSensor<sensor_msgs::msg::PointCloud2>>(
         current_simulation_time, configuration,
         node.create_publisher<sensor_msgs::msg::PointCloud2>(
-          "/perception/obstacle_segmentation/pointcloud", 1)));
+          "/perception/obstacle_segmentation/pointcloud", 1),
+        raycaster->raycaster));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -120,6 +152,18 @@ public:
     const simulation_api_schema::UpdateTrafficLightsRequest &) -> void;
 
 private:
+  /**
+   * @brief Raycaster shared by the lidar sensors attached to the same entity with the same
+   *        static environment setting.
+   * @note  The scans of those sensors are traced against one scene, updated once per frame.
+   */
+  struct LidarRaycaster
+  {
+    std::string entity;
+    bool static_environment;
+    std::shared_ptr<Raycaster> raycaster;
+  };
+  std::vector<LidarRaycaster> lidar_raycasters_;
   std::vector<std::unique_ptr<LidarSensorBase>> lidar_sensors_;
   std::vector<std::unique_ptr<DetectionSensorBase>> detection_sensors_;
   std::vector<std::unique_ptr<OccupancyGridSensorBase>> occupancy_grid_sensors_;
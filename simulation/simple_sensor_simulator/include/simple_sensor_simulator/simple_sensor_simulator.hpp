@@ -28,10 +28,12 @@
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/ego_entity_simulation.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <string>
 #include <thread>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/shared_map_image.hpp>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -102,6 +104,10 @@ private:
   auto updateEntityStatus(const simulation_api_schema::UpdateEntityStatusRequest &)
     -> simulation_api_schema::UpdateEntityStatusResponse;
 
+  /// @note Applies entity status, traffic lights and time of a frame in this order.
+  auto frameStep(const simulation_api_schema::FrameStepRequest &)
+    -> simulation_api_schema::FrameStepResponse;
+
   auto spawnVehicleEntity(const simulation_api_schema::SpawnVehicleEntityRequest &)
     -> simulation_api_schema::SpawnVehicleEntityResponse;
 
@@ -137,6 +143,8 @@ private:
 
   int getSocketPort();
 
+  auto getTransportProtocol() -> simulation_interface::TransportProtocol;
+
   std::vector<traffic_simulator_msgs::VehicleParameters> ego_vehicles_;
   std::vector<traffic_simulator_msgs::VehicleParameters> vehicles_;
   std::vector<traffic_simulator_msgs::PedestrianParameters> pedestrians_;
@@ -148,11 +156,17 @@ private:
   rclcpp::Time current_ros_time_;
   bool initialized_;
   std::map<std::string, simulation_api_schema::EntityStatus> entity_status_;
+  simulation_interface::EntityStatusDeltaDecoder entity_status_delta_decoder_;
   simulation_api_schema::UpdateTrafficLightsRequest traffic_signals_states_;
   traffic_simulator_msgs::BoundingBox getBoundingBox(const std::string & name);
   zeromq::MultiServer server_;
   geographic_msgs::msg::GeoPoint getOrigin();
+  /// @note Loads the lanelet map on first use, since only the ego and traffic lights need it.
+  auto getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &;
+  boost::filesystem::path lanelet2_map_path_;
+  boost::filesystem::path prebuilt_map_path_;
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
+  std::shared_ptr<const hdmap_utils::SharedMapImage> shared_map_image_;
   std::shared_ptr<vehicle_simulation::EgoEntitySimulation> ego_entity_simulation_;
 
   bool isEgo(const std::string & name);
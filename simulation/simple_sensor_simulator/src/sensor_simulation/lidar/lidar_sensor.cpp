@@ -24,19 +24,34 @@
 
 namespace simple_sensor_simulator
 {
-template <>
-auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
-  const rclcpp::Time & current_ros_time) -> sensor_msgs::msg::PointCloud2
+auto LidarSensorBase::startScan(
+  const double current_simulation_time,
+  const std::vector<traffic_simulator_msgs::EntityStatus> & entities)
+  -> std::optional<Raycaster::Scan>
 {
-  std::optional<geometry_msgs::msg::Pose> ego_pose;
-
+  if (
+    current_simulation_time - previous_simulation_time_ - configuration_.scan_duration() <
+    -0.002) {
+    return std::nullopt;
+  }
   for (const auto & entity : entities) {
     if (configuration_.entity() == entity.name()) {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(entity.pose(), pose);
-      ego_pose = pose;
-    } else {
+      previous_simulation_time_ = current_simulation_time;
+      Raycaster::Scan scan;
+      simulation_interface::toMsg(entity.pose(), scan.origin);
+      scan.rotation_matrices = &rotation_matrices_;
+      return scan;
+    }
+  }
+  throw simple_sensor_simulator::SimulationRuntimeError("failed to find ego vehicle");
+}
+
+auto addEntities(
+  Raycaster & raycaster, const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
+  const std::string & sensor_entity) -> void
+{
+  for (const auto & entity : entities) {
+    if (sensor_entity != entity.name()) {
       geometry_msgs::msg::Pose pose;
       simulation_interface::toMsg(entity.pose(), pose);
       auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
@@ -47,7 +62,7 @@ auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
       pose.position.x = pose.position.x + center.x();
       pose.position.y = pose.position.y + center.y();
       pose.position.z = pose.position.z + center.z();
-      raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
+      raycaster.addPrimitive<simple_sensor_simulator::primitives::Box>(
         entity.name(),                           //
         entity.bounding_box().dimensions().x(),  //
         entity.bounding_box().dimensions().y(),  //
@@ -55,17 +70,5 @@ auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
         pose);
     }
   }
-
-  if (ego_pose) {
-    std::vector<double> vertical_angles;
-    for (const auto vertical_angle : configuration_.vertical_angles()) {
-      vertical_angles.push_back(vertical_angle);
-    }
-    const auto pointcloud = raycaster_.raycast("base_link", current_ros_time, ego_pose.value());
-    detected_objects_ = raycaster_.getDetectedObject();
-    return pointcloud;
-  } else {
-    throw simple_sensor_simulator::SimulationRuntimeError("failed to find ego vehicle");
-  }
 }
 }  // namespace simple_sensor_simulator
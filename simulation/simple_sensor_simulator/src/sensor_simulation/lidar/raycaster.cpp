@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <set>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <string>
@@ -29,25 +31,63 @@ Raycaster::Raycaster()
 : primitive_ptrs_(0),
   device_(rtcNewDevice(nullptr)),
   scene_(rtcNewScene(device_)),
+  packet_width_(getPacketWidth(device_)),
   engine_(seed_gen_())
 {
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
+  rtcCommitScene(scene_);
 }
 
 Raycaster::Raycaster(std::string embree_config)
 : primitive_ptrs_(0),
   device_(rtcNewDevice(embree_config.c_str())),
   scene_(rtcNewScene(device_)),
+  packet_width_(getPacketWidth(device_)),
+  engine_(seed_gen_())
+{
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
+  rtcCommitScene(scene_);
+}
+
+Raycaster::Raycaster(RTCDevice device)
+: primitive_ptrs_(0),
+  device_(device),
+  scene_(rtcNewScene(device_)),
+  packet_width_(getPacketWidth(device_)),
   engine_(seed_gen_())
 {
+  rtcRetainDevice(device_);
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
+  rtcCommitScene(scene_);
 }
 
 Raycaster::~Raycaster()
 {
+  for (const auto & [name, instance] : instances_) {
+    detachInstance(instance);
+  }
+  if (static_environment_) {
+    detachInstance(static_environment_.value());
+  }
   rtcReleaseScene(scene_);
   rtcReleaseDevice(device_);
 }
 
-void Raycaster::setDirection(
+std::size_t Raycaster::getPacketWidth(RTCDevice device)
+{
+  if (rtcGetDeviceProperty(device, RTC_DEVICE_PROPERTY_NATIVE_RAY16_SUPPORTED)) {
+    return 16;
+  } else if (rtcGetDeviceProperty(device, RTC_DEVICE_PROPERTY_NATIVE_RAY8_SUPPORTED)) {
+    return 8;
+  } else {
+    return 1;
+  }
+}
+
+std::vector<Eigen::Matrix3d> Raycaster::getRotationMatrices(
   const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
   double horizontal_angle_end)
 {
@@ -56,96 +96,220 @@ void Raycaster::setDirection(
     vertical_angles.emplace_back(v);
   }
 
-  auto quat_directions = getDirections(
-    vertical_angles, horizontal_angle_start, horizontal_angle_end,
-    configuration.horizontal_resolution());
-  rotation_matrices_.clear();
-  for (const auto & q : quat_directions) {
-    rotation_matrices_.push_back(quaternion_operation::getRotationMatrix(q));
+  std::vector<Eigen::Matrix3d> rotation_matrices;
+  for (const auto & q : getDirections(
+         vertical_angles, horizontal_angle_start, horizontal_angle_end,
+         configuration.horizontal_resolution())) {
+    rotation_matrices.push_back(quaternion_operation::getRotationMatrix(q));
   }
+  return rotation_matrices;
 }
 
 std::vector<geometry_msgs::msg::Quaternion> Raycaster::getDirections(
   const std::vector<double> & vertical_angles, double horizontal_angle_start,
   double horizontal_angle_end, double horizontal_resolution)
 {
-  if (
-    directions_.empty() || previous_horizontal_angle_start_ != horizontal_angle_start ||
-    previous_horizontal_angle_end_ != horizontal_angle_end ||
-    previous_horizontal_resolution_ != horizontal_resolution ||
-    previous_vertical_angles_ != vertical_angles) {
-    std::vector<geometry_msgs::msg::Quaternion> directions;
-    double horizontal_angle = horizontal_angle_start;
-    while (horizontal_angle <= horizontal_angle_end) {
-      horizontal_angle = horizontal_angle + horizontal_resolution;
-      for (const auto vertical_angle : vertical_angles) {
-        geometry_msgs::msg::Vector3 rpy;
-        rpy.x = 0;
-        rpy.y = vertical_angle;
-        rpy.z = horizontal_angle;
-        auto quat = quaternion_operation::convertEulerAngleToQuaternion(rpy);
-        directions.emplace_back(quat);
-      }
+  std::vector<geometry_msgs::msg::Quaternion> directions;
+  double horizontal_angle = horizontal_angle_start;
+  while (horizontal_angle <= horizontal_angle_end) {
+    horizontal_angle = horizontal_angle + horizontal_resolution;
+    for (const auto vertical_angle : vertical_angles) {
+      geometry_msgs::msg::Vector3 rpy;
+      rpy.x = 0;
+      rpy.y = vertical_angle;
+      rpy.z = horizontal_angle;
+      auto quat = quaternion_operation::convertEulerAngleToQuaternion(rpy);
+      directions.emplace_back(quat);
     }
-    directions_ = directions;
-    previous_horizontal_angle_end_ = horizontal_angle_end;
-    previous_horizontal_angle_start_ = horizontal_angle_start;
-    previous_horizontal_resolution_ = horizontal_resolution;
-    previous_vertical_angles_ = vertical_angles;
   }
-  return directions_;
+  return directions;
+}
+
+void Raycaster::detachInstance(const Instance & instance)
+{
+  rtcDetachGeometry(scene_, instance.geometry_id);
+  rtcReleaseGeometry(instance.geometry);
+  rtcReleaseScene(instance.prototype);
+  geometry_ids_.erase(instance.geometry_id);
 }
 
-const std::vector<std::string> & Raycaster::getDetectedObject() const { return detected_objects_; }
+void Raycaster::setStaticEnvironment(const primitives::Primitive & environment)
+{
+  // the static geometry is never rebuilt, so it is worth spending time for a better BVH
+  attachStaticEnvironment(
+    environment.createPrototype(device_, RTC_BUILD_QUALITY_HIGH), environment.getTransformMatrix());
+}
 
-const sensor_msgs::msg::PointCloud2 Raycaster::raycast(
-  const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
-  double max_distance, double min_distance)
+std::shared_ptr<Raycaster> Raycaster::shareStaticEnvironment() const
 {
-  detected_objects_ = {};
-  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>());
-  for (auto & pair : primitive_ptrs_) {
-    auto id = pair.second->addToScene(device_, scene_);
-    geometry_ids_.insert({id, pair.first});
+  if (not static_environment_) {
+    throw std::runtime_error("raycaster without static environment cannot share it.");
   }
+  // the constructor is private, so std::make_shared is not available
+  auto raycaster = std::shared_ptr<Raycaster>(new Raycaster(device_));
+  rtcRetainScene(static_environment_->prototype);
+  raycaster->attachStaticEnvironment(
+    static_environment_->prototype, static_environment_->transform);
+  return raycaster;
+}
 
-  // Run as many threads as physical cores (which is usually /2 virtual threads)
-  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
-  // This also minimizes cost of creating a thread (roughly 10us on Intel/Linux)
-  int thread_count = std::thread::hardware_concurrency() / 2;
-  // Per thread data structures:
-  std::vector<std::thread> threads(thread_count);
-  std::vector<std::set<unsigned int>> thread_detected_ids(thread_count);
-  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> thread_cloud(thread_count);
-
-  rtcCommitScene(scene_);
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    thread_cloud[i] = pcl::PointCloud<pcl::PointXYZI>::Ptr(new pcl::PointCloud<pcl::PointXYZI>());
-    threads[i] = std::thread(
-      intersect, i, thread_count, scene_, thread_cloud[i], origin, std::ref(thread_detected_ids[i]),
-      max_distance, min_distance, std::ref(rotation_matrices_));
+void Raycaster::attachStaticEnvironment(
+  RTCScene prototype, const std::array<float, 12> & transform)
+{
+  if (static_environment_) {
+    detachInstance(static_environment_.value());
   }
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-    (*cloud) += *(thread_cloud[i]);
+  Instance instance;
+  instance.prototype = prototype;
+  instance.geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(instance.geometry, instance.prototype);
+  // enable raycasting
+  rtcSetGeometryMask(instance.geometry, 0b11111111'11111111'11111111'11111111);
+  instance.transform = transform;
+  rtcSetGeometryTransform(
+    instance.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, instance.transform.data());
+  rtcCommitGeometry(instance.geometry);
+  instance.geometry_id = rtcAttachGeometry(scene_, instance.geometry);
+  static_environment_ = std::move(instance);
+  rtcCommitScene(scene_);
+}
+
+void Raycaster::updateScene()
+{
+  bool modified = false;
+  for (auto iter = instances_.begin(); iter != instances_.end();) {
+    if (primitive_ptrs_.count(iter->first) == 0) {
+      detachInstance(iter->second);
+      iter = instances_.erase(iter);
+      modified = true;
+    } else {
+      ++iter;
+    }
   }
-  for (auto && detected_ids_in_thread : thread_detected_ids) {
-    for (const auto & id : detected_ids_in_thread) {
-      detected_objects_.emplace_back(geometry_ids_[id]);
+  for (auto & [name, primitive_ptr] : primitive_ptrs_) {
+    auto iter = instances_.find(name);
+    bool created = false;
+    if (iter != instances_.end() and not iter->second.primitive->hasSameShape(*primitive_ptr)) {
+      detachInstance(iter->second);
+      instances_.erase(iter);
+      iter = instances_.end();
     }
+    if (iter == instances_.end()) {
+      Instance instance;
+      instance.prototype = primitive_ptr->createPrototype(device_);
+      instance.geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance.geometry, instance.prototype);
+      // enable raycasting
+      rtcSetGeometryMask(instance.geometry, 0b11111111'11111111'11111111'11111111);
+      instance.geometry_id = rtcAttachGeometry(scene_, instance.geometry);
+      instance.transform = {};
+      geometry_ids_.emplace(instance.geometry_id, name);
+      iter = instances_.emplace(name, std::move(instance)).first;
+      created = true;
+    }
+    auto & instance = iter->second;
+    if (const auto transform = primitive_ptr->getTransformMatrix();
+        created or transform != instance.transform) {
+      rtcSetGeometryTransform(
+        instance.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, transform.data());
+      rtcCommitGeometry(instance.geometry);
+      instance.transform = transform;
+      modified = true;
+    }
+    instance.primitive = std::move(primitive_ptr);
+  }
+  primitive_ptrs_.clear();
+  if (modified) {
+    rtcCommitScene(scene_);
   }
+}
 
-  for (const auto & id : geometry_ids_) {
-    rtcDetachGeometry(scene_, id.first);
+std::vector<Raycaster::Result> Raycaster::raycast(
+  const std::string & frame_id, const rclcpp::Time & stamp, const std::vector<Scan> & scans)
+{
+  updateScene();
+
+  std::vector<Result> results(scans.size());
+  std::size_t tile_count = 0;
+  for (std::size_t scan_index = 0; scan_index < scans.size(); ++scan_index) {
+    const auto ray_count = scans[scan_index].rotation_matrices->size();
+    sensor_msgs::PointCloud2Modifier modifier(results[scan_index].pointcloud);
+    modifier.setPointCloud2Fields(
+      4, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1,
+      sensor_msgs::msg::PointField::FLOAT32, "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "intensity", 1, sensor_msgs::msg::PointField::FLOAT32);
+    // room for all rays to hit, so that each tile writes its points in place from its first ray
+    modifier.resize(ray_count);
+    for (std::size_t begin = 0; begin < ray_count; begin += tile_size) {
+      if (tiles_.size() <= tile_count) {
+        tiles_.emplace_back();
+      }
+      tiles_[tile_count].scan = scan_index;
+      tiles_[tile_count].begin = begin;
+      tiles_[tile_count].end = std::min(begin + tile_size, ray_count);
+      ++tile_count;
+    }
   }
 
-  geometry_ids_.clear();
-  primitive_ptrs_.clear();
+  thread_pool_.run(tile_count, [&](const std::size_t tile_index) {
+    auto & tile = tiles_[tile_index];
+    tile.point_count = 0;
+    tile.detected_ids.clear();
+    const auto & scan = scans[tile.scan];
+    auto data = results[tile.scan].pointcloud.data.data() + tile.begin * sizeof(Point);
+    switch (packet_width_) {
+      case 16:
+        intersectPackets<16, RTCRayHit16>(
+          tile.begin, tile.end, scene_, tile, data, scan.origin, scan.max_distance,
+          scan.min_distance, *scan.rotation_matrices,
+          [](const int * valid, RTCScene scene, RTCRayHit16 * rayhit) {
+            rtcIntersect16(valid, scene, rayhit);
+          });
+        break;
+      case 8:
+        intersectPackets<8, RTCRayHit8>(
+          tile.begin, tile.end, scene_, tile, data, scan.origin, scan.max_distance,
+          scan.min_distance, *scan.rotation_matrices,
+          [](const int * valid, RTCScene scene, RTCRayHit8 * rayhit) {
+            rtcIntersect8(valid, scene, rayhit);
+          });
+        break;
+      default:
+        intersect(
+          tile.begin, tile.end, scene_, tile, data, scan.origin, scan.max_distance,
+          scan.min_distance, *scan.rotation_matrices);
+        break;
+    }
+  });
 
-  sensor_msgs::msg::PointCloud2 pointcloud_msg;
-  pcl::toROSMsg(*cloud, pointcloud_msg);
-  pointcloud_msg.header.frame_id = frame_id;
-  pointcloud_msg.header.stamp = stamp;
-  return pointcloud_msg;
+  // close the gaps of the rays which did not hit anything between tiles of each scan
+  std::vector<std::size_t> point_counts(scans.size(), 0);
+  std::vector<std::set<unsigned int>> detected_ids(scans.size());
+  for (std::size_t tile_index = 0; tile_index < tile_count; ++tile_index) {
+    const auto & tile = tiles_[tile_index];
+    auto & point_count = point_counts[tile.scan];
+    if (tile.begin != point_count and tile.point_count != 0) {
+      auto data = results[tile.scan].pointcloud.data.data();
+      std::memmove(
+        data + point_count * sizeof(Point), data + tile.begin * sizeof(Point),
+        tile.point_count * sizeof(Point));
+    }
+    point_count += tile.point_count;
+    detected_ids[tile.scan].insert(tile.detected_ids.begin(), tile.detected_ids.end());
+  }
+
+  for (std::size_t scan_index = 0; scan_index < scans.size(); ++scan_index) {
+    auto & result = results[scan_index];
+    sensor_msgs::PointCloud2Modifier(result.pointcloud).resize(point_counts[scan_index]);
+    result.pointcloud.is_dense = true;
+    result.pointcloud.header.frame_id = frame_id;
+    result.pointcloud.header.stamp = stamp;
+    for (const auto & id : detected_ids[scan_index]) {
+      if (const auto iter = geometry_ids_.find(id); iter != geometry_ids_.end()) {
+        result.detected_objects.emplace_back(iter->second);
+      }
+    }
+  }
+  return results;
 }
 }  // namespace simple_sensor_simulator
@@ -15,6 +15,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <array>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
@@ -66,6 +67,28 @@ std::vector<geometry_msgs::msg::Point> toPoints(const std::vector<Vertex> & v)
 
 namespace primitives
 {
+namespace
+{
+unsigned int attachMesh(
+  RTCDevice device, RTCScene scene, const std::vector<Vertex> & vertices,
+  const std::vector<Triangle> & triangles)
+{
+  RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+  Vertex * vertex_buffer = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex), vertices.size()));
+  std::copy(vertices.begin(), vertices.end(), vertex_buffer);
+  Triangle * triangle_buffer = static_cast<Triangle *>(rtcSetNewGeometryBuffer(
+    mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles.size()));
+  std::copy(triangles.begin(), triangles.end(), triangle_buffer);
+  // enable raycasting
+  rtcSetGeometryMask(mesh, 0b11111111'11111111'11111111'11111111);
+  rtcCommitGeometry(mesh);
+  unsigned int geometry_id = rtcAttachGeometry(scene, mesh);
+  rtcReleaseGeometry(mesh);
+  return geometry_id;
+}
+}  // namespace
+
 Primitive::Primitive(std::string type, const geometry_msgs::msg::Pose & pose)
 : type(type), pose(pose)
 {
@@ -116,25 +139,43 @@ std::vector<geometry_msgs::msg::Point> Primitive::get2DConvexHull() const
 
 unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
 {
-  RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
-  const auto transformed_vertices = transform();
-  Vertex * vertices = static_cast<Vertex *>(rtcSetNewGeometryBuffer(
-    mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vertex),
-    transformed_vertices.size()));
-  for (size_t i = 0; i < transformed_vertices.size(); i++) {
-    vertices[i] = transformed_vertices[i];
-  }
-  Triangle * triangles = static_cast<Triangle *>(rtcSetNewGeometryBuffer(
-    mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles_.size()));
-  for (size_t i = 0; i < triangles_.size(); i++) {
-    triangles[i] = triangles_[i];
-  }
-  // enable raycasting
-  rtcSetGeometryMask(mesh, 0b11111111'11111111'11111111'11111111);
-  rtcCommitGeometry(mesh);
-  unsigned int geometry_id = rtcAttachGeometry(scene, mesh);
-  rtcReleaseGeometry(mesh);
-  return geometry_id;
+  return attachMesh(device, scene, transform(), triangles_);
+}
+
+RTCScene Primitive::createPrototype(RTCDevice device, RTCBuildQuality build_quality) const
+{
+  RTCScene prototype = rtcNewScene(device);
+  rtcSetSceneBuildQuality(prototype, build_quality);
+  attachMesh(device, prototype, vertices_, triangles_);
+  rtcCommitScene(prototype);
+  return prototype;
+}
+
+std::array<float, 12> Primitive::getTransformMatrix() const
+{
+  const auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
+  return {
+    static_cast<float>(rotation(0, 0)), static_cast<float>(rotation(1, 0)),
+    static_cast<float>(rotation(2, 0)), static_cast<float>(rotation(0, 1)),
+    static_cast<float>(rotation(1, 1)), static_cast<float>(rotation(2, 1)),
+    static_cast<float>(rotation(0, 2)), static_cast<float>(rotation(1, 2)),
+    static_cast<float>(rotation(2, 2)), static_cast<float>(pose.position.x),
+    static_cast<float>(pose.position.y), static_cast<float>(pose.position.z)};
+}
+
+bool Primitive::hasSameShape(const Primitive & other) const
+{
+  return type == other.type and
+         std::equal(
+           vertices_.begin(), vertices_.end(), other.vertices_.begin(), other.vertices_.end(),
+           [](const Vertex & a, const Vertex & b) {
+             return a.x == b.x and a.y == b.y and a.z == b.z;
+           }) and
+         std::equal(
+           triangles_.begin(), triangles_.end(), other.triangles_.begin(), other.triangles_.end(),
+           [](const Triangle & a, const Triangle & b) {
+             return a.v0 == b.v0 and a.v1 == b.v1 and a.v2 == b.v2;
+           });
 }
 
 std::optional<double> Primitive::getMax(const math::geometry::Axis & axis) const
@@ -0,0 +1,139 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <simple_sensor_simulator/sensor_simulation/primitives/static_environment.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+namespace
+{
+/// @note Normalized arc length of each point of the line string, from 0 to 1.
+std::vector<double> getProgress(const std::vector<geometry_msgs::msg::Point> & points)
+{
+  std::vector<double> progress(points.size(), 0.0);
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    const auto dx = points[i].x - points[i - 1].x;
+    const auto dy = points[i].y - points[i - 1].y;
+    const auto dz = points[i].z - points[i - 1].z;
+    progress[i] = progress[i - 1] + std::hypot(dx, dy, dz);
+  }
+  if (not progress.empty() and progress.back() > 0.0) {
+    for (auto & value : progress) {
+      value /= progress.back();
+    }
+  }
+  return progress;
+}
+
+/// @note Types of line strings extruded to walls, and their typical heights in meters.
+const std::vector<std::pair<std::string, double>> wall_heights = {
+  {"curbstone", 0.15}, {"road_border", 0.15}, {"guard_rail", 0.8}, {"fence", 1.5}, {"wall", 3.0}};
+}  // namespace
+
+StaticEnvironment::StaticEnvironment()
+: Primitive("StaticEnvironment", geometry_msgs::msg::Pose())
+{
+}
+
+StaticEnvironment::StaticEnvironment(const hdmap_utils::HdMapUtils & hdmap_utils)
+: StaticEnvironment()
+{
+  for (const auto lanelet_id : hdmap_utils.getLaneletIds()) {
+    addSurface(hdmap_utils.getLeftBound(lanelet_id), hdmap_utils.getRightBound(lanelet_id));
+  }
+  for (const auto & [type, height] : wall_heights) {
+    for (const auto & line_string : hdmap_utils.getLineStrings({type})) {
+      addWall(line_string, height);
+    }
+  }
+}
+
+StaticEnvironment::StaticEnvironment(const hdmap_utils::SharedMapImage & shared_map_image)
+: StaticEnvironment()
+{
+  for (const auto & [left_bound, right_bound] : shared_map_image.getLaneletBounds()) {
+    addSurface(left_bound, right_bound);
+  }
+  for (const auto & [type, height] : wall_heights) {
+    for (const auto & line_string : shared_map_image.getLineStrings(type)) {
+      addWall(line_string, height);
+    }
+  }
+}
+
+void StaticEnvironment::addSurface(
+  const std::vector<geometry_msgs::msg::Point> & left_bound,
+  const std::vector<geometry_msgs::msg::Point> & right_bound)
+{
+  if (left_bound.size() < 2 or right_bound.size() < 2) {
+    return;
+  }
+  const auto left_offset = static_cast<unsigned int>(vertices_.size());
+  const auto right_offset = static_cast<unsigned int>(left_offset + left_bound.size());
+  for (const auto & point : left_bound) {
+    vertices_.push_back(toVertex(point));
+  }
+  for (const auto & point : right_bound) {
+    vertices_.push_back(toVertex(point));
+  }
+  // zip both bounds into a strip, always advancing on the bound which is behind the other
+  const auto left_progress = getProgress(left_bound);
+  const auto right_progress = getProgress(right_bound);
+  for (std::size_t l = 0, r = 0; l + 1 < left_bound.size() or r + 1 < right_bound.size();) {
+    if (
+      r + 1 == right_bound.size() or
+      (l + 1 < left_bound.size() and left_progress[l + 1] <= right_progress[r + 1])) {
+      triangles_.push_back(
+        {static_cast<unsigned int>(left_offset + l), static_cast<unsigned int>(right_offset + r),
+         static_cast<unsigned int>(left_offset + l + 1)});
+      ++l;
+    } else {
+      triangles_.push_back(
+        {static_cast<unsigned int>(left_offset + l), static_cast<unsigned int>(right_offset + r),
+         static_cast<unsigned int>(right_offset + r + 1)});
+      ++r;
+    }
+  }
+}
+
+void StaticEnvironment::addWall(
+  const std::vector<geometry_msgs::msg::Point> & line_string, double height)
+{
+  if (line_string.size() < 2) {
+    return;
+  }
+  const auto offset = static_cast<unsigned int>(vertices_.size());
+  for (const auto & point : line_string) {
+    auto top = point;
+    top.z += height;
+    vertices_.push_back(toVertex(point));
+    vertices_.push_back(toVertex(top));
+  }
+  for (unsigned int i = 0; i + 1 < line_string.size(); ++i) {
+    const auto bottom = offset + 2 * i;
+    const auto top = bottom + 1;
+    const auto next_bottom = bottom + 2;
+    const auto next_top = bottom + 3;
+    triangles_.push_back({bottom, next_bottom, top});
+    triangles_.push_back({top, next_bottom, next_top});
+  }
+}
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
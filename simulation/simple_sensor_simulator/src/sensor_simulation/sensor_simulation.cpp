@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include <memory>
+#include <optional>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -26,8 +28,33 @@ auto SensorSimulation::updateSensorFrame(
 {
   std::vector<std::string> lidar_detected_objects = {};
 
+  std::vector<std::optional<Raycaster::Scan>> lidar_scans;
   for (auto & sensor : lidar_sensors_) {
-    sensor->update(current_simulation_time, entities, current_ros_time);
+    lidar_scans.push_back(sensor->startScan(current_simulation_time, entities));
+  }
+
+  std::vector<std::optional<Raycaster::Result>> lidar_results(lidar_sensors_.size());
+  for (const auto & lidar_raycaster : lidar_raycasters_) {
+    std::vector<Raycaster::Scan> scans;
+    std::vector<std::size_t> sensor_indices;
+    for (std::size_t i = 0; i < lidar_sensors_.size(); ++i) {
+      if (lidar_scans[i] and lidar_sensors_[i]->getRaycaster() == lidar_raycaster.raycaster) {
+        scans.push_back(lidar_scans[i].value());
+        sensor_indices.push_back(i);
+      }
+    }
+    if (not scans.empty()) {
+      addEntities(*lidar_raycaster.raycaster, entities, lidar_raycaster.entity);
+      auto results = lidar_raycaster.raycaster->raycast("base_link", current_ros_time, scans);
+      for (std::size_t i = 0; i < results.size(); ++i) {
+        lidar_results[sensor_indices[i]] = std::move(results[i]);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < lidar_sensors_.size(); ++i) {
+    auto & sensor = lidar_sensors_[i];
+    sensor->update(current_simulation_time, std::move(lidar_results[i]), current_ros_time);
     for (const auto & object : sensor->getDetectedObjects()) {
       if (std::count(lidar_detected_objects.begin(), lidar_detected_objects.end(), object) == 0) {
         lidar_detected_objects.push_back(object);
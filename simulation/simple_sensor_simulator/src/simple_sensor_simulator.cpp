@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <geometry_msgs/msg/pose_stamped.hpp>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
@@ -32,7 +33,7 @@ namespace simple_sensor_simulator
 ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
 : Node("simple_sensor_simulator", options),
   server_(
-    simulation_interface::protocol, simulation_interface::HostName::ANY, getSocketPort(),
+    getTransportProtocol(), simulation_interface::HostName::ANY, getSocketPort(),
     [this](auto &&... xs) { return initialize(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return updateFrame(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) { return spawnVehicleEntity(std::forward<decltype(xs)>(xs)...); },
@@ -47,7 +48,8 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
     [this](auto &&... xs) {
       return attachPseudoTrafficLightDetector(std::forward<decltype(xs)>(xs)...);
     },
-    [this](auto &&... xs) { return updateStepTime(std::forward<decltype(xs)>(xs)...); })
+    [this](auto &&... xs) { return updateStepTime(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return frameStep(std::forward<decltype(xs)>(xs)...); })
 {
 }
 
@@ -70,12 +72,31 @@ geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
 
 ScenarioSimulator::~ScenarioSimulator() {}
 
+auto ScenarioSimulator::getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &
+{
+  if (not hdmap_utils_) {
+    /// @note Attach to the prebuilt map traffic_simulator has built, if it has the same key.
+    hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(
+      lanelet2_map_path_, prebuilt_map_path_, getOrigin());
+  }
+  return hdmap_utils_;
+}
+
 int ScenarioSimulator::getSocketPort()
 {
   if (!has_parameter("port")) declare_parameter("port", 5555);
   return get_parameter("port").as_int();
 }
 
+auto ScenarioSimulator::getTransportProtocol() -> simulation_interface::TransportProtocol
+{
+  if (!has_parameter("transport_protocol"))
+    declare_parameter(
+      "transport_protocol", simulation_interface::enumToString(simulation_interface::protocol));
+  return simulation_interface::toTransportProtocol(
+    get_parameter("transport_protocol").as_string());
+}
+
 auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeRequest & req)
   -> simulation_api_schema::InitializeResponse
 {
@@ -87,7 +108,16 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   builtin_interfaces::msg::Time t;
   simulation_interface::toMsg(req.initialize_ros_time(), t);
   current_ros_time_ = t;
-  hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(req.lanelet2_map_path(), getOrigin());
+  /**
+   * @note Map the geometry of the map traffic_simulator has built in place, instead of loading the
+   * map again. The map itself is loaded only if the ego or traffic lights need it.
+   */
+  lanelet2_map_path_ = req.lanelet2_map_path();
+  prebuilt_map_path_ = req.prebuilt_map_path();
+  hdmap_utils_.reset();
+  shared_map_image_ = hdmap_utils::SharedMapImage::open(
+    hdmap_utils::HdMapUtils::prebuiltMapKey(lanelet2_map_path_),
+    hdmap_utils::SharedMapImage::imagePath(prebuilt_map_path_));
   auto res = simulation_api_schema::InitializeResponse();
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to initialize simulation");
@@ -96,6 +126,7 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   pedestrians_.clear();
   misc_objects_.clear();
   entity_status_.clear();
+  entity_status_delta_decoder_.clear();
   return res;
 }
 
@@ -142,6 +173,27 @@ auto ScenarioSimulator::updateStepTime(const simulation_api_schema::UpdateStepTi
   return res;
 }
 
+auto ScenarioSimulator::frameStep(const simulation_api_schema::FrameStepRequest & req)
+  -> simulation_api_schema::FrameStepResponse
+{
+  auto res = simulation_api_schema::FrameStepResponse();
+  auto succeeded = true;
+  if (req.has_update_entity_status()) {
+    *res.mutable_update_entity_status() = updateEntityStatus(req.update_entity_status());
+    succeeded = succeeded and res.update_entity_status().result().success();
+  }
+  if (req.has_update_traffic_lights()) {
+    *res.mutable_update_traffic_lights() = updateTrafficLights(req.update_traffic_lights());
+    succeeded = succeeded and res.update_traffic_lights().result().success();
+  }
+  if (req.has_update_frame()) {
+    *res.mutable_update_frame() = updateFrame(req.update_frame());
+    succeeded = succeeded and res.update_frame().result().success();
+  }
+  res.mutable_result()->set_success(succeeded);
+  return res;
+}
+
 auto ScenarioSimulator::updateEntityStatus(
   const simulation_api_schema::UpdateEntityStatusRequest & req)
   -> simulation_api_schema::UpdateEntityStatusResponse
@@ -154,22 +206,26 @@ auto ScenarioSimulator::updateEntityStatus(
     updated_status->mutable_pose()->CopyFrom(status.pose());
   };
 
+  auto simulateEgo = [&](const simulation_api_schema::EntityStatus & status) {
+    assert(ego_entity_simulation_ && "Ego is spawned but ego_entity_simulation_ is nullptr!");
+    if (req.overwrite_ego_status()) {
+      traffic_simulator_msgs::msg::EntityStatus ego_status_msg;
+      simulation_interface::toMsg(status, ego_status_msg);
+      ego_entity_simulation_->overwrite(
+        ego_status_msg, current_scenario_time_ + step_time_, step_time_, req.npc_logic_started());
+    } else {
+      ego_entity_simulation_->update(
+        current_scenario_time_ + step_time_, step_time_, req.npc_logic_started());
+    }
+    simulation_api_schema::EntityStatus ego_status;
+    simulation_interface::toProto(ego_entity_simulation_->getStatus(), ego_status);
+    return ego_status;
+  };
+
   for (const auto & status : req.status()) {
     try {
       if (isEgo(status.name())) {
-        assert(ego_entity_simulation_ && "Ego is spawned but ego_entity_simulation_ is nullptr!");
-        if (req.overwrite_ego_status()) {
-          traffic_simulator_msgs::msg::EntityStatus ego_status_msg;
-          simulation_interface::toMsg(status, ego_status_msg);
-          ego_entity_simulation_->overwrite(
-            ego_status_msg, current_scenario_time_ + step_time_, step_time_,
-            req.npc_logic_started());
-        } else {
-          ego_entity_simulation_->update(
-            current_scenario_time_ + step_time_, step_time_, req.npc_logic_started());
-        }
-        simulation_api_schema::EntityStatus ego_status;
-        simulation_interface::toProto(ego_entity_simulation_->getStatus(), ego_status);
+        const auto ego_status = simulateEgo(status);
         entity_status_.at(status.name()) = ego_status;
         copyStatusToResponse(ego_status);
       } else {
@@ -181,6 +237,23 @@ auto ScenarioSimulator::updateEntityStatus(
     }
   }
 
+  /// @note In the delta mode, only ego is sent back, since other entities are not changed here.
+  for (const auto & delta : req.status_delta()) {
+    const auto & name = entity_status_delta_decoder_.name(delta);
+    const auto status = entity_status_.find(name);
+    if (status == entity_status_.end()) {
+      THROW_SEMANTIC_ERROR("Entity ", std::quoted(name), " does not exist");
+    }
+    entity_status_delta_decoder_.decode(delta, status->second);
+    if (isEgo(name)) {
+      status->second = simulateEgo(status->second);
+      auto updated_delta = res.add_status_delta();
+      updated_delta->set_id(delta.id());
+      *updated_delta->mutable_action_status() = status->second.action_status();
+      *updated_delta->mutable_pose() = status->second.pose();
+    }
+  }
+
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("");
   return res;
@@ -227,7 +300,7 @@ auto ScenarioSimulator::spawnVehicleEntity(
       return get_parameter("consider_pose_by_road_slope").as_bool();
     };
     ego_entity_simulation_ = std::make_shared<vehicle_simulation::EgoEntitySimulation>(
-      parameters, step_time_, hdmap_utils_,
+      parameters, step_time_, getHdmapUtils(),
       get_parameter_or("use_sim_time", rclcpp::Parameter("use_sim_time", false)),
       get_consider_acceleration_by_road_slope(), get_consider_pose_by_road_slope());
     traffic_simulator_msgs::msg::EntityStatus initial_status;
@@ -296,6 +369,7 @@ auto ScenarioSimulator::despawnEntity(const simulation_api_schema::DespawnEntity
                                       remove_despawn_requested_entity_from(misc_objects_);
   if (any_entity_was_removed) {
     entity_status_.erase(req.name());
+    entity_status_delta_decoder_.erase(req.name());
   }
   auto res = simulation_api_schema::DespawnEntityResponse();
   res.mutable_result()->set_success(any_entity_was_removed);
@@ -316,7 +390,13 @@ auto ScenarioSimulator::attachLidarSensor(
   const simulation_api_schema::AttachLidarSensorRequest & req)
   -> simulation_api_schema::AttachLidarSensorResponse
 {
-  sensor_sim_.attachLidarSensor(current_simulation_time_, req.configuration(), *this);
+  sensor_sim_.attachLidarSensor(current_simulation_time_, req.configuration(), *this, [this]() {
+    if (shared_map_image_) {
+      return primitives::StaticEnvironment(*shared_map_image_);
+    } else {
+      return primitives::StaticEnvironment(*getHdmapUtils());
+    }
+  });
   auto res = simulation_api_schema::AttachLidarSensorResponse();
   res.mutable_result()->set_success(true);
   return res;
@@ -348,7 +428,7 @@ auto ScenarioSimulator::attachPseudoTrafficLightDetector(
 {
   auto response = simulation_api_schema::AttachPseudoTrafficLightDetectorResponse();
   sensor_sim_.attachPseudoTrafficLightsDetector(
-    current_simulation_time_, req.configuration(), *this, hdmap_utils_);
+    current_simulation_time_, req.configuration(), *this, getHdmapUtils());
   response.mutable_result()->set_success(true);
   return response;
 }
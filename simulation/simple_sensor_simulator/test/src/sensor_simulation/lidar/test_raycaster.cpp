@@ -0,0 +1,258 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <geometry_msgs/msg/pose.hpp>
+#include <rclcpp/time.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <string>
+#include <vector>
+
+using simple_sensor_simulator::Raycaster;
+using simple_sensor_simulator::primitives::Box;
+
+auto makePose(const double x, const double y, const double z = 0.0) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.position.z = z;
+  return pose;
+}
+
+/// @note Horizontal rays, whose directions are the first columns of the rotation matrices.
+auto makeRotationMatrix(const double yaw) -> Eigen::Matrix3d
+{
+  Eigen::Matrix3d rotation_matrix;
+  rotation_matrix << std::cos(yaw), -std::sin(yaw), 0, std::sin(yaw), std::cos(yaw), 0, 0, 0, 1;
+  return rotation_matrix;
+}
+
+/**
+ * @note Rays in runs of 300 alternately go forward within 0.5 rad and backward, so that whole tiles
+ * of rays (1024 rays each) and parts of tiles miss a box in front of the origin.
+ */
+auto makeRotationMatrices(const std::size_t ray_count) -> std::vector<Eigen::Matrix3d>
+{
+  std::vector<Eigen::Matrix3d> rotation_matrices;
+  for (std::size_t i = 0; i < ray_count; ++i) {
+    rotation_matrices.push_back(
+      makeRotationMatrix((i / 300) % 2 == 0 ? 0.5 * std::sin(0.1 * i) : M_PI));
+  }
+  return rotation_matrices;
+}
+
+auto makeScan(
+  const geometry_msgs::msg::Pose & origin, const std::vector<Eigen::Matrix3d> & rotation_matrices)
+  -> Raycaster::Scan
+{
+  Raycaster::Scan scan;
+  scan.origin = origin;
+  scan.rotation_matrices = &rotation_matrices;
+  return scan;
+}
+
+auto getPoints(const sensor_msgs::msg::PointCloud2 & pointcloud) -> std::vector<Eigen::Vector3d>
+{
+  std::vector<Eigen::Vector3d> points;
+  sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> y(pointcloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> z(pointcloud, "z");
+  for (; x != x.end(); ++x, ++y, ++z) {
+    points.emplace_back(*x, *y, *z);
+  }
+  return points;
+}
+
+/// @note Points of the rays from the origin which hit the plane of x = distance in front of it.
+auto getExpectedPoints(const std::vector<Eigen::Matrix3d> & rotation_matrices, double distance)
+  -> std::vector<Eigen::Vector3d>
+{
+  std::vector<Eigen::Vector3d> points;
+  for (const auto & rotation_matrix : rotation_matrices) {
+    if (rotation_matrix(0) > 0) {
+      points.emplace_back(distance, distance * rotation_matrix(1) / rotation_matrix(0), 0.0);
+    }
+  }
+  return points;
+}
+
+auto expectPointsNear(
+  const std::vector<Eigen::Vector3d> & actual, const std::vector<Eigen::Vector3d> & expected)
+  -> void
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i].x(), expected[i].x(), 1e-3) << "point " << i;
+    EXPECT_NEAR(actual[i].y(), expected[i].y(), 1e-3) << "point " << i;
+    EXPECT_NEAR(actual[i].z(), expected[i].z(), 1e-3) << "point " << i;
+  }
+}
+
+/// @note Detected objects are in the order of their ids in the scene, which is not specified.
+auto expectSameResult(const Raycaster::Result & actual, const Raycaster::Result & expected) -> void
+{
+  expectPointsNear(getPoints(actual.pointcloud), getPoints(expected.pointcloud));
+  auto actual_objects = actual.detected_objects;
+  auto expected_objects = expected.detected_objects;
+  std::sort(actual_objects.begin(), actual_objects.end());
+  std::sort(expected_objects.begin(), expected_objects.end());
+  EXPECT_EQ(actual_objects, expected_objects);
+}
+
+TEST(Raycaster, BoxInFront)
+{
+  Raycaster raycaster;
+  raycaster.addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(10.0, 0.0));
+  const auto rotation_matrices = makeRotationMatrices(600);
+  const auto results =
+    raycaster.raycast("base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)});
+  ASSERT_EQ(results.size(), static_cast<std::size_t>(1));
+  expectPointsNear(getPoints(results[0].pointcloud), getExpectedPoints(rotation_matrices, 9.0));
+  EXPECT_EQ(results[0].detected_objects, std::vector<std::string>({"box"}));
+  EXPECT_EQ(results[0].pointcloud.header.frame_id, "base_link");
+}
+
+/**
+ * @note Rays are traced in packets of 8 or 16 if the CPU supports them, and one by one on a device
+ * restricted to SSE2, which does not. Both must give the same points in the same order.
+ */
+TEST(Raycaster, PacketsAndSingleRays)
+{
+  Raycaster packet_raycaster;
+  Raycaster single_ray_raycaster("isa=sse2");
+  /// @note Not multiples of the packet widths, so that the last packets are partially masked out.
+  for (const auto ray_count : {1, 7, 15, 17, 1000}) {
+    const auto rotation_matrices = makeRotationMatrices(ray_count);
+    std::vector<Raycaster::Result> results;
+    for (auto raycaster : {&packet_raycaster, &single_ray_raycaster}) {
+      raycaster->addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(10.0, 0.0));
+      raycaster->addPrimitive<Box>("small_box", 1.0, 1.0, 1.0, makePose(5.0, 0.5));
+      results.push_back(raycaster->raycast(
+        "base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)})[0]);
+    }
+    expectSameResult(results[0], results[1]);
+  }
+}
+
+/// @note The points of each tile are moved next to those of the previous tile after tracing.
+TEST(Raycaster, TileBoundary)
+{
+  Raycaster raycaster;
+  for (const auto ray_count : {1023, 1024, 1025, 2048, 4097}) {
+    raycaster.addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(10.0, 0.0));
+    const auto rotation_matrices = makeRotationMatrices(ray_count);
+    const auto results = raycaster.raycast(
+      "base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)});
+    expectPointsNear(getPoints(results[0].pointcloud), getExpectedPoints(rotation_matrices, 9.0));
+    EXPECT_EQ(results[0].detected_objects, std::vector<std::string>({"box"}));
+  }
+}
+
+/// @note Many entities, so that consecutive rays hit different ones within and across tiles.
+TEST(Raycaster, TileBoundaryWithManyEntities)
+{
+  Raycaster raycaster;
+  const auto rotation_matrices = makeRotationMatrices(3000);
+  std::vector<std::string> names;
+  for (int i = 0; i < 100; ++i) {
+    names.push_back("box" + std::to_string(i));
+  }
+  const auto add_boxes = [&](Raycaster & raycaster) {
+    for (int i = 0; i < 100; ++i) {
+      raycaster.addPrimitive<Box>(names[i], 0.5, 0.1, 1.0, makePose(10.0, 0.2 * (i - 50)));
+    }
+  };
+  add_boxes(raycaster);
+  const auto result = raycaster.raycast(
+    "base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)})[0];
+  Raycaster single_ray_raycaster("isa=sse2");
+  add_boxes(single_ray_raycaster);
+  const auto expected = single_ray_raycaster.raycast(
+    "base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)})[0];
+  expectSameResult(result, expected);
+  EXPECT_FALSE(result.detected_objects.empty());
+  /// @note Rays between the boxes hit the sides of them.
+  for (const auto & point : getPoints(result.pointcloud)) {
+    EXPECT_GE(point.x(), 9.75 - 1e-3);
+    EXPECT_LE(point.x(), 10.25 + 1e-3);
+  }
+}
+
+TEST(Raycaster, MultipleScans)
+{
+  const auto rotation_matrices = makeRotationMatrices(2500);
+  const auto other_rotation_matrices = makeRotationMatrices(700);
+  const std::vector<Raycaster::Scan> scans = {
+    makeScan(makePose(0, 0), rotation_matrices), makeScan(makePose(3, 1), other_rotation_matrices)};
+  Raycaster raycaster;
+  const auto add_boxes = [&]() {
+    raycaster.addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(10.0, 0.0));
+    raycaster.addPrimitive<Box>("small_box", 1.0, 1.0, 1.0, makePose(7.0, 1.0));
+  };
+  add_boxes();
+  const auto results = raycaster.raycast("base_link", rclcpp::Time(0), scans);
+  ASSERT_EQ(results.size(), scans.size());
+  for (std::size_t i = 0; i < scans.size(); ++i) {
+    add_boxes();
+    expectSameResult(results[i], raycaster.raycast("base_link", rclcpp::Time(0), {scans[i]})[0]);
+  }
+  EXPECT_TRUE(raycaster.raycast("base_link", rclcpp::Time(0), {}).empty());
+}
+
+/// @note Primitives are added every frame, and the scene keeps up with their poses and shapes.
+TEST(Raycaster, UpdateScene)
+{
+  Raycaster raycaster;
+  const auto rotation_matrices = makeRotationMatrices(600);
+  const auto raycast = [&]() {
+    return raycaster.raycast(
+      "base_link", rclcpp::Time(0), {makeScan(makePose(0, 0), rotation_matrices)})[0];
+  };
+  raycaster.addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(10.0, 0.0));
+  expectPointsNear(getPoints(raycast().pointcloud), getExpectedPoints(rotation_matrices, 9.0));
+  {
+    raycaster.addPrimitive<Box>("box", 2.0, 200.0, 10.0, makePose(20.0, 0.0));
+    const auto result = raycast();
+    expectPointsNear(getPoints(result.pointcloud), getExpectedPoints(rotation_matrices, 19.0));
+    EXPECT_EQ(result.detected_objects, std::vector<std::string>({"box"}));
+  }
+  {
+    raycaster.addPrimitive<Box>("box", 6.0, 200.0, 10.0, makePose(20.0, 0.0));
+    expectPointsNear(getPoints(raycast().pointcloud), getExpectedPoints(rotation_matrices, 17.0));
+  }
+  {
+    raycaster.addPrimitive<Box>("other_box", 2.0, 200.0, 10.0, makePose(30.0, 0.0));
+    const auto result = raycast();
+    expectPointsNear(getPoints(result.pointcloud), getExpectedPoints(rotation_matrices, 29.0));
+    EXPECT_EQ(result.detected_objects, std::vector<std::string>({"other_box"}));
+  }
+  {
+    const auto result = raycast();
+    EXPECT_TRUE(getPoints(result.pointcloud).empty());
+    EXPECT_TRUE(result.detected_objects.empty());
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
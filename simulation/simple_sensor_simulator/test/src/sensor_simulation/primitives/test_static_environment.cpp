@@ -0,0 +1,163 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <cmath>
+#include <simple_sensor_simulator/sensor_simulation/primitives/static_environment.hpp>
+#include <string>
+#include <vector>
+
+using simple_sensor_simulator::primitives::StaticEnvironment;
+
+auto makePoint(const double x, const double y, const double z = 0.0) -> geometry_msgs::msg::Point
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  point.z = z;
+  return point;
+}
+
+/// @note Sum of the areas of the triangles, which is that of the surface if none of them overlap.
+auto getArea(const StaticEnvironment & environment) -> double
+{
+  const auto vertices = environment.getVertex();
+  auto area = 0.0;
+  for (const auto & triangle : environment.getTriangles()) {
+    const auto & v0 = vertices.at(triangle.v0);
+    const auto & v1 = vertices.at(triangle.v1);
+    const auto & v2 = vertices.at(triangle.v2);
+    const double ax = v1.x - v0.x, ay = v1.y - v0.y, az = v1.z - v0.z;
+    const double bx = v2.x - v0.x, by = v2.y - v0.y, bz = v2.z - v0.z;
+    area += 0.5 * std::hypot(ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx);
+  }
+  return area;
+}
+
+TEST(StaticEnvironment, addSurface)
+{
+  StaticEnvironment environment;
+  environment.addSurface(
+    {makePoint(0, 1), makePoint(1, 1), makePoint(2, 1)},
+    {makePoint(0, -1), makePoint(1, -1), makePoint(2, -1)});
+  EXPECT_EQ(environment.getVertex().size(), static_cast<std::size_t>(6));
+  const auto triangles = environment.getTriangles();
+  ASSERT_EQ(triangles.size(), static_cast<std::size_t>(4));
+  /// @note Left bound is vertices 0 to 2 and right bound is 3 to 5, advanced alternately.
+  const std::vector<std::vector<unsigned int>> expected = {
+    {0, 3, 1}, {1, 3, 4}, {1, 4, 2}, {2, 4, 5}};
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    EXPECT_EQ(triangles[i].v0, expected[i][0]);
+    EXPECT_EQ(triangles[i].v1, expected[i][1]);
+    EXPECT_EQ(triangles[i].v2, expected[i][2]);
+  }
+  EXPECT_NEAR(getArea(environment), 4.0, 1e-6);
+}
+
+TEST(StaticEnvironment, addSurfaceWithDifferentNumbersOfPoints)
+{
+  StaticEnvironment environment;
+  environment.addSurface(
+    {makePoint(0, 1), makePoint(4, 1)},
+    {makePoint(0, -1), makePoint(1, -1), makePoint(2, -1), makePoint(3, -1), makePoint(4, -1)});
+  EXPECT_EQ(environment.getVertex().size(), static_cast<std::size_t>(7));
+  EXPECT_EQ(environment.getTriangles().size(), static_cast<std::size_t>(5));
+  EXPECT_NEAR(getArea(environment), 8.0, 1e-6);
+}
+
+TEST(StaticEnvironment, addSurfaceWithDegenerateBound)
+{
+  StaticEnvironment environment;
+  environment.addSurface({makePoint(0, 1)}, {makePoint(0, -1), makePoint(1, -1)});
+  EXPECT_TRUE(environment.getVertex().empty());
+  EXPECT_TRUE(environment.getTriangles().empty());
+}
+
+TEST(StaticEnvironment, addWall)
+{
+  StaticEnvironment environment;
+  environment.addWall({makePoint(0, 0, 1), makePoint(3, 0, 1), makePoint(3, 4, 1)}, 1.5);
+  const auto vertices = environment.getVertex();
+  ASSERT_EQ(vertices.size(), static_cast<std::size_t>(6));
+  /// @note Bottom and top of each point of the line string, in this order.
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    EXPECT_FLOAT_EQ(vertices[i].z, i % 2 == 0 ? 1.0 : 2.5);
+  }
+  EXPECT_EQ(environment.getTriangles().size(), static_cast<std::size_t>(4));
+  EXPECT_NEAR(getArea(environment), (3.0 + 4.0) * 1.5, 1e-6);
+}
+
+TEST(StaticEnvironment, addWallAfterSurface)
+{
+  StaticEnvironment environment;
+  environment.addSurface({makePoint(0, 1), makePoint(1, 1)}, {makePoint(0, -1), makePoint(1, -1)});
+  environment.addWall({makePoint(0, 1), makePoint(1, 1)}, 1.0);
+  const auto triangles = environment.getTriangles();
+  ASSERT_EQ(triangles.size(), static_cast<std::size_t>(4));
+  /// @note Triangles of the wall refer to its own vertices, which follow those of the surface.
+  for (std::size_t i = 2; i < triangles.size(); ++i) {
+    for (const auto index : {triangles[i].v0, triangles[i].v1, triangles[i].v2}) {
+      EXPECT_GE(index, 4u);
+      EXPECT_LT(index, 8u);
+    }
+  }
+  EXPECT_NEAR(getArea(environment), 2.0 + 1.0, 1e-6);
+}
+
+TEST(StaticEnvironment, LaneletMap)
+{
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const hdmap_utils::HdMapUtils hdmap_utils(
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm",
+    origin);
+  const StaticEnvironment environment(hdmap_utils);
+  const auto vertices = environment.getVertex();
+  const auto triangles = environment.getTriangles();
+  EXPECT_FALSE(triangles.empty());
+  for (const auto & triangle : triangles) {
+    EXPECT_LT(triangle.v0, vertices.size());
+    EXPECT_LT(triangle.v1, vertices.size());
+    EXPECT_LT(triangle.v2, vertices.size());
+  }
+}
+
+/// @note The environment built from the shared map image is supposed to match that from the map.
+TEST(StaticEnvironment, SharedMapImage)
+{
+  const auto path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto shared_map_image = hdmap_utils::SharedMapImage::open(
+    hdmap_utils::HdMapUtils::prebuiltMapKey(path),
+    hdmap_utils::SharedMapImage::imagePath(hdmap_utils.getPrebuiltMapPath()));
+  ASSERT_TRUE(shared_map_image);
+  const StaticEnvironment environment(hdmap_utils);
+  const StaticEnvironment shared_environment(*shared_map_image);
+  EXPECT_EQ(shared_environment.getVertex().size(), environment.getVertex().size());
+  EXPECT_EQ(shared_environment.getTriangles().size(), environment.getTriangles().size());
+  EXPECT_DOUBLE_EQ(getArea(shared_environment), getArea(environment));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,10 +19,17 @@
 
 namespace simulation_interface
 {
-enum class TransportProtocol { TCP /*, UDP*/ };
+/**
+ * @note IPC and INPROC can be used only if the client and the server are on the same host, or in
+ *       the same process respectively. Their endpoints are named after the port number, so the
+ *       hostname is ignored.
+ */
+enum class TransportProtocol { TCP, IPC, INPROC /*, UDP*/ };
 
 std::string enumToString(const TransportProtocol & protocol);
 
+TransportProtocol toTransportProtocol(const std::string & protocol);
+
 enum class HostName { LOCALHOST, ANY };
 
 std::string enumToString(const HostName & hostname);
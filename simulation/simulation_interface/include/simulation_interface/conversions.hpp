@@ -157,6 +157,15 @@ void toMsg(
 void toMsg(
   const simulation_api_schema::EntityStatus & proto,
   traffic_simulator_msgs::msg::EntityStatus & status);
+/// @note Converts all fields but time, which the delta mode does not send.
+void toProto(
+  const traffic_simulator_msgs::msg::EntityStatus & status,
+  simulation_api_schema::EntityStatusDelta & proto);
+/// @note Converts only fields which differ from the previous status. Returns false if none differ.
+auto toProto(
+  const traffic_simulator_msgs::msg::EntityStatus & status,
+  const traffic_simulator_msgs::msg::EntityStatus & previous_status,
+  simulation_api_schema::EntityStatusDelta & proto) -> bool;
 void toProto(
   const builtin_interfaces::msg::Duration & duration, builtin_interfaces::Duration & proto);
 void toMsg(
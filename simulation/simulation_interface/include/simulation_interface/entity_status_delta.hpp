@@ -0,0 +1,87 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+#define SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+
+#include <simulation_api_schema.pb.h>
+
+#include <cstdint>
+#include <string>
+#include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <unordered_map>
+
+namespace simulation_interface
+{
+/**
+ * @brief Sender of the delta mode of UpdateEntityStatusRequest.
+ * @note Ids are given by the caller, and must not be reused for another entity.
+ */
+class EntityStatusDeltaEncoder
+{
+public:
+  /**
+   * @brief Encode the fields of the status changed since the frame it was sent last.
+   * @param full If true, all fields are encoded even if they are not changed.
+   * @return Whether the delta has to be sent, which is false if no field is changed.
+   * @note The name is encoded only if the id has not been sent yet.
+   */
+  auto encode(
+    const std::uint64_t id, const traffic_simulator_msgs::msg::EntityStatus & status,
+    const bool full, simulation_api_schema::EntityStatusDelta & delta) -> bool;
+
+  /**
+   * @brief Ends the frame, after the simulator has received it.
+   * @note Ids not encoded in the frame, i.e. despawned entities, are forgotten.
+   */
+  auto flush() -> void;
+
+  /// @note Drops the frame the simulator may not have received, so that the next one is full.
+  auto reset() -> void;
+
+  /// @note Name of the entity sent by the id, to read the response to the last frame.
+  auto name(const std::uint64_t id) const -> const std::string &;
+
+private:
+  std::unordered_map<std::uint64_t, traffic_simulator_msgs::msg::EntityStatus> sent_statuses_;
+
+  std::unordered_map<std::uint64_t, traffic_simulator_msgs::msg::EntityStatus> encoded_statuses_;
+};
+
+/**
+ * @brief Receiver of the delta mode of UpdateEntityStatusRequest.
+ */
+class EntityStatusDeltaDecoder
+{
+public:
+  /// @note Name of the entity of the delta, which is registered if the delta carries it.
+  auto name(const simulation_api_schema::EntityStatusDelta & delta) -> const std::string &;
+
+  /// @note Overwrite the fields of the status the delta carries.
+  auto decode(
+    const simulation_api_schema::EntityStatusDelta & delta,
+    simulation_api_schema::EntityStatus & status) const -> void;
+
+  /// @note Forget the ids of the despawned entity, whose name may be spawned again with a new id.
+  auto erase(const std::string & name) -> void;
+
+  /// @note Forget all ids, on initializing the simulation for another scenario.
+  auto clear() -> void;
+
+private:
+  std::unordered_map<std::uint64_t, std::string> names_;
+};
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
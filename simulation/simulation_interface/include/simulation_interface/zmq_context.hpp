@@ -0,0 +1,32 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__ZMQ_CONTEXT_HPP_
+#define SIMULATION_INTERFACE__ZMQ_CONTEXT_HPP_
+
+#include <memory>
+#include <simulation_interface/constants.hpp>
+#include <zmqpp/zmqpp.hpp>
+
+namespace zeromq
+{
+/**
+ * @brief Returns the context for a socket of the protocol.
+ * @note  inproc endpoints are only visible to sockets of the same context, so all sockets using
+ *        INPROC share one context per process. Other protocols get a context of their own.
+ */
+auto getContext(const simulation_interface::TransportProtocol &) -> std::shared_ptr<zmqpp::context>;
+}  // namespace zeromq
+
+#endif  // SIMULATION_INTERFACE__ZMQ_CONTEXT_HPP_
@@ -23,6 +23,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/zmq_context.hpp>
 #include <string>
 #include <thread>
 #include <zmqpp/zmqpp.hpp>
@@ -82,11 +83,14 @@ public:
   auto call(const simulation_api_schema::AttachPseudoTrafficLightDetectorRequest &)
     -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse;
 
+  auto call(const simulation_api_schema::FrameStepRequest &)
+    -> simulation_api_schema::FrameStepResponse;
+
   const simulation_interface::TransportProtocol protocol;
   const std::string hostname;
 
 private:
-  zmqpp::context context_;
+  const std::shared_ptr<zmqpp::context> context_;
   const zmqpp::socket_type type_;
   zmqpp::socket socket_;
 
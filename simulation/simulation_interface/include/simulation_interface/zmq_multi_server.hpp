@@ -18,9 +18,11 @@
 #include <simulation_api_schema.pb.h>
 
 #include <functional>
+#include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/zmq_context.hpp>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -35,9 +37,9 @@ public:
   explicit MultiServer(
     const simulation_interface::TransportProtocol & protocol,
     const simulation_interface::HostName & hostname, const unsigned int socket_port, Ts &&... xs)
-  : context_(zmqpp::context()),
+  : context_(getContext(protocol)),
     type_(zmqpp::socket_type::reply),
-    socket_(context_, type_),
+    socket_(*context_, type_),
     functions_(std::forward<decltype(xs)>(xs)...)
   {
     socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
@@ -51,7 +53,7 @@ private:
   void poll();
   void start_poll();
   std::thread thread_;
-  const zmqpp::context context_;
+  const std::shared_ptr<zmqpp::context> context_;
   const zmqpp::socket_type type_;
   zmqpp::poller poller_;
   zmqpp::socket socket_;
@@ -73,6 +75,7 @@ private:
   DEFINE_FUNCTION_TYPE(UpdateTrafficLights);
   DEFINE_FUNCTION_TYPE(AttachPseudoTrafficLightDetector);
   DEFINE_FUNCTION_TYPE(UpdateStepTime);
+  DEFINE_FUNCTION_TYPE(FrameStep);
 
 #undef DEFINE_FUNCTION_TYPE
 
@@ -80,7 +83,7 @@ private:
     Initialize, UpdateFrame, SpawnVehicleEntity, SpawnPedestrianEntity, SpawnMiscObjectEntity,
     DespawnEntity, UpdateEntityStatus, AttachLidarSensor, AttachDetectionSensor,
     AttachOccupancyGridSensor, UpdateTrafficLights, AttachPseudoTrafficLightDetector,
-    UpdateStepTime>
+    UpdateStepTime, FrameStep>
     functions_;
 };
 }  // namespace zeromq
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <iomanip>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
 #include <string>
@@ -21,15 +22,22 @@ namespace simulation_interface
 std::string getEndPoint(
   const TransportProtocol & protocol, const HostName & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" +
-         simulation_interface::enumToString(hostname) + ":" + std::to_string(port);
+  return getEndPoint(protocol, simulation_interface::enumToString(hostname), port);
 }
 
 std::string getEndPoint(
   const TransportProtocol & protocol, const std::string & hostname, const unsigned int & port)
 {
-  return simulation_interface::enumToString(protocol) + "://" + hostname + ":" +
-         std::to_string(port);
+  switch (protocol) {
+    case TransportProtocol::TCP:
+      return simulation_interface::enumToString(protocol) + "://" + hostname + ":" +
+             std::to_string(port);
+    case TransportProtocol::IPC:
+      return "ipc:///tmp/simulation_interface_" + std::to_string(port);
+    case TransportProtocol::INPROC:
+      return "inproc://simulation_interface_" + std::to_string(port);
+  }
+  THROW_SIMULATION_ERROR("Protocol should be TCP, IPC or INPROC.");  // LCOV_EXCL_LINE
 }
 
 std::string enumToString(const TransportProtocol & protocol)
@@ -37,12 +45,28 @@ std::string enumToString(const TransportProtocol & protocol)
   switch (protocol) {
     case TransportProtocol::TCP:
       return "tcp";
+    case TransportProtocol::IPC:
+      return "ipc";
+    case TransportProtocol::INPROC:
+      return "inproc";
       /*
     case TransportProtocol::UDP:
       return "udp";              
       */
   }
-  THROW_SIMULATION_ERROR("Protocol should be TCP.");  // LCOV_EXCL_LINE
+  THROW_SIMULATION_ERROR("Protocol should be TCP, IPC or INPROC.");  // LCOV_EXCL_LINE
+}
+
+TransportProtocol toTransportProtocol(const std::string & protocol)
+{
+  for (const auto & candidate :
+       {TransportProtocol::TCP, TransportProtocol::IPC, TransportProtocol::INPROC}) {
+    if (protocol == enumToString(candidate)) {
+      return candidate;
+    }
+  }
+  THROW_SIMULATION_ERROR(
+    "Unsupported transport protocol ", std::quoted(protocol), ". It should be tcp, ipc or inproc.");
 }
 
 std::string enumToString(const HostName & hostname)
@@ -442,6 +442,41 @@ void toMsg(
   status.lanelet_pose_valid = false;
 }
 
+void toProto(
+  const traffic_simulator_msgs::msg::EntityStatus & status,
+  simulation_api_schema::EntityStatusDelta & proto)
+{
+  toProto(status.type, *proto.mutable_type());
+  toProto(status.subtype, *proto.mutable_subtype());
+  toProto(status.action_status, *proto.mutable_action_status());
+  toProto(status.pose, *proto.mutable_pose());
+}
+
+auto toProto(
+  const traffic_simulator_msgs::msg::EntityStatus & status,
+  const traffic_simulator_msgs::msg::EntityStatus & previous_status,
+  simulation_api_schema::EntityStatusDelta & proto) -> bool
+{
+  auto changed = false;
+  if (status.type != previous_status.type) {
+    toProto(status.type, *proto.mutable_type());
+    changed = true;
+  }
+  if (status.subtype != previous_status.subtype) {
+    toProto(status.subtype, *proto.mutable_subtype());
+    changed = true;
+  }
+  if (status.action_status != previous_status.action_status) {
+    toProto(status.action_status, *proto.mutable_action_status());
+    changed = true;
+  }
+  if (status.pose != previous_status.pose) {
+    toProto(status.pose, *proto.mutable_pose());
+    changed = true;
+  }
+  return changed;
+}
+
 void toProto(
   const builtin_interfaces::msg::Duration & duration, builtin_interfaces::Duration & proto)
 {
@@ -0,0 +1,108 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iterator>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+#include <utility>
+
+namespace simulation_interface
+{
+auto EntityStatusDeltaEncoder::encode(
+  const std::uint64_t id, const traffic_simulator_msgs::msg::EntityStatus & status,
+  const bool full, simulation_api_schema::EntityStatusDelta & delta) -> bool
+{
+  delta.set_id(id);
+  const auto sent = sent_statuses_.find(id);
+  if (sent == sent_statuses_.end()) {
+    delta.set_name(status.name);
+    toProto(status, delta);
+  } else if (full) {
+    toProto(status, delta);
+  } else if (not toProto(status, sent->second, delta)) {
+    encoded_statuses_.emplace(id, status);
+    return false;
+  }
+  encoded_statuses_.emplace(id, status);
+  return true;
+}
+
+auto EntityStatusDeltaEncoder::flush() -> void
+{
+  sent_statuses_ = std::move(encoded_statuses_);
+  encoded_statuses_.clear();
+}
+
+auto EntityStatusDeltaEncoder::reset() -> void
+{
+  sent_statuses_.clear();
+  encoded_statuses_.clear();
+}
+
+auto EntityStatusDeltaEncoder::name(const std::uint64_t id) const -> const std::string &
+{
+  const auto sent = sent_statuses_.find(id);
+  if (sent != sent_statuses_.end()) {
+    return sent->second.name;
+  } else {
+    THROW_SIMULATION_ERROR("Entity id ", id, " is not sent to the simulator.");
+  }
+}
+
+auto EntityStatusDeltaDecoder::name(const simulation_api_schema::EntityStatusDelta & delta)
+  -> const std::string &
+{
+  if (not delta.name().empty()) {
+    names_[delta.id()] = delta.name();
+  }
+  const auto name = names_.find(delta.id());
+  if (name != names_.end()) {
+    return name->second;
+  } else {
+    THROW_SIMULATION_ERROR("Entity id ", delta.id(), " is sent before its name.");
+  }
+}
+
+auto EntityStatusDeltaDecoder::decode(
+  const simulation_api_schema::EntityStatusDelta & delta,
+  simulation_api_schema::EntityStatus & status) const -> void
+{
+  if (delta.has_type()) {
+    *status.mutable_type() = delta.type();
+  }
+  if (delta.has_subtype()) {
+    *status.mutable_subtype() = delta.subtype();
+  }
+  if (delta.has_action_status()) {
+    *status.mutable_action_status() = delta.action_status();
+  }
+  if (delta.has_pose()) {
+    *status.mutable_pose() = delta.pose();
+  }
+}
+
+auto EntityStatusDeltaDecoder::erase(const std::string & name) -> void
+{
+  for (auto iter = names_.begin(); iter != names_.end();) {
+    iter = iter->second == name ? names_.erase(iter) : std::next(iter);
+  }
+}
+
+auto EntityStatusDeltaDecoder::clear() -> void
+{
+  names_.clear();
+}
+}  // namespace simulation_interface
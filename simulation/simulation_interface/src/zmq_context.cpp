@@ -0,0 +1,38 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mutex>
+#include <simulation_interface/zmq_context.hpp>
+
+namespace zeromq
+{
+auto getContext(const simulation_interface::TransportProtocol & protocol)
+  -> std::shared_ptr<zmqpp::context>
+{
+  if (protocol == simulation_interface::TransportProtocol::INPROC) {
+    static std::mutex mutex;
+    static std::weak_ptr<zmqpp::context> shared_context;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto context = shared_context.lock()) {
+      return context;
+    } else {
+      context = std::make_shared<zmqpp::context>();
+      shared_context = context;
+      return context;
+    }
+  } else {
+    return std::make_shared<zmqpp::context>();
+  }
+}
+}  // namespace zeromq
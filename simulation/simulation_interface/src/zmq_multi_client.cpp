@@ -23,9 +23,9 @@ MultiClient::MultiClient(
   const unsigned int socket_port)
 : protocol(protocol),
   hostname(hostname),
-  context_(zmqpp::context()),
+  context_(getContext(protocol)),
   type_(zmqpp::socket_type::request),
-  socket_(context_, type_)
+  socket_(*context_, type_)
 {
   socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
 }
@@ -206,4 +206,16 @@ auto MultiClient::call(
     return {};
   }
 }
+
+auto MultiClient::call(const simulation_api_schema::FrameStepRequest & request)
+  -> simulation_api_schema::FrameStepResponse
+{
+  if (is_running) {
+    simulation_api_schema::SimulationRequest sim_request;
+    *sim_request.mutable_frame_step() = request;
+    return call(sim_request).frame_step();
+  } else {
+    return {};
+  }
+}
 }  // namespace zeromq
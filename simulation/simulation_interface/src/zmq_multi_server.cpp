@@ -82,6 +82,9 @@ void MultiServer::poll()
         *sim_response.mutable_update_step_time() =
           std::get<UpdateStepTime>(functions_)(proto.update_step_time());
         break;
+      case simulation_api_schema::SimulationRequest::RequestCase::kFrameStep:
+        *sim_response.mutable_frame_step() = std::get<FrameStep>(functions_)(proto.frame_step());
+        break;
       case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
         THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
       }
@@ -0,0 +1,60 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/constants.hpp>
+#include <simulation_interface/zmq_context.hpp>
+
+TEST(Constants, getEndPoint)
+{
+  using simulation_interface::getEndPoint;
+  using simulation_interface::HostName;
+  using simulation_interface::TransportProtocol;
+  EXPECT_EQ(getEndPoint(TransportProtocol::TCP, HostName::ANY, 5555), "tcp://*:5555");
+  EXPECT_EQ(getEndPoint(TransportProtocol::TCP, "localhost", 5555), "tcp://localhost:5555");
+  EXPECT_EQ(
+    getEndPoint(TransportProtocol::IPC, HostName::ANY, 5555),
+    getEndPoint(TransportProtocol::IPC, "localhost", 5555));
+  EXPECT_EQ(
+    getEndPoint(TransportProtocol::INPROC, HostName::ANY, 5555),
+    getEndPoint(TransportProtocol::INPROC, "localhost", 5555));
+  EXPECT_EQ(getEndPoint(TransportProtocol::INPROC, "localhost", 5555).rfind("inproc://", 0), 0);
+}
+
+TEST(Constants, toTransportProtocol)
+{
+  using simulation_interface::toTransportProtocol;
+  using simulation_interface::TransportProtocol;
+  EXPECT_EQ(toTransportProtocol("tcp"), TransportProtocol::TCP);
+  EXPECT_EQ(toTransportProtocol("ipc"), TransportProtocol::IPC);
+  EXPECT_EQ(toTransportProtocol("inproc"), TransportProtocol::INPROC);
+  EXPECT_THROW(toTransportProtocol("udp"), common::SimulationError);
+}
+
+TEST(Constants, getContext)
+{
+  using simulation_interface::TransportProtocol;
+  const auto inproc_context = zeromq::getContext(TransportProtocol::INPROC);
+  EXPECT_EQ(zeromq::getContext(TransportProtocol::INPROC), inproc_context);
+  const auto tcp_context = zeromq::getContext(TransportProtocol::TCP);
+  EXPECT_NE(zeromq::getContext(TransportProtocol::TCP), tcp_context);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
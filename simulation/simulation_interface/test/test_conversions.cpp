@@ -380,6 +380,40 @@ TEST(Conversion, SentEntityStatus)
   EXPECT_SENT_ENTITY_STATUS_EQ(status, proto);
 }
 
+TEST(Conversion, EntityStatusDelta)
+{
+  traffic_simulator_msgs::msg::EntityStatus status;
+  status.name = "test";
+  status.time = 3.0;
+  status.action_status.current_action = "test";
+  status.action_status.twist.linear.x = 1.0;
+  status.pose.position.x = 4.0;
+  status.pose.orientation.w = 1.0;
+  {
+    simulation_api_schema::EntityStatusDelta proto;
+    simulation_interface::toProto(status, proto);
+    EXPECT_TRUE(proto.has_type());
+    EXPECT_TRUE(proto.has_subtype());
+    EXPECT_ACTION_STATUS_EQ(status.action_status, proto.action_status());
+    EXPECT_POSE_EQ(status.pose, proto.pose());
+  }
+  auto previous_status = status;
+  previous_status.time = 2.0;
+  {
+    simulation_api_schema::EntityStatusDelta proto;
+    EXPECT_FALSE(simulation_interface::toProto(status, previous_status, proto));
+    EXPECT_FALSE(proto.has_type() or proto.has_subtype());
+    EXPECT_FALSE(proto.has_action_status() or proto.has_pose());
+  }
+  previous_status.pose.position.x = 3.0;
+  {
+    simulation_api_schema::EntityStatusDelta proto;
+    EXPECT_TRUE(simulation_interface::toProto(status, previous_status, proto));
+    EXPECT_FALSE(proto.has_type() or proto.has_subtype() or proto.has_action_status());
+    EXPECT_POSE_EQ(status.pose, proto.pose());
+  }
+}
+
 TEST(Conversion, Time)
 {
   builtin_interfaces::Time proto;
@@ -0,0 +1,195 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Statuses = std::vector<std::pair<std::uint64_t, traffic_simulator_msgs::msg::EntityStatus>>;
+
+using SimulatorStatuses = std::map<std::string, simulation_api_schema::EntityStatus>;
+
+auto makeStatus(const std::string & name, const double x)
+  -> traffic_simulator_msgs::msg::EntityStatus
+{
+  traffic_simulator_msgs::msg::EntityStatus status;
+  status.name = name;
+  status.type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  status.pose.position.x = x;
+  status.action_status.twist.linear.x = 1.0;
+  return status;
+}
+
+/**
+ * @brief Encode the statuses of a frame as traffic_simulator does, and pass them through the wire.
+ */
+auto send(simulation_interface::EntityStatusDeltaEncoder & encoder, const Statuses & statuses)
+  -> simulation_api_schema::UpdateEntityStatusRequest
+{
+  simulation_api_schema::UpdateEntityStatusRequest request;
+  for (const auto & status : statuses) {
+    simulation_api_schema::EntityStatusDelta delta;
+    if (encoder.encode(status.first, status.second, false, delta)) {
+      *request.add_status_delta() = delta;
+    }
+  }
+  encoder.flush();
+  std::string buffer;
+  request.SerializeToString(&buffer);
+  simulation_api_schema::UpdateEntityStatusRequest received;
+  received.ParseFromString(buffer);
+  return received;
+}
+
+/**
+ * @brief Decode the request as simple_sensor_simulator does.
+ */
+auto receive(
+  simulation_interface::EntityStatusDeltaDecoder & decoder,
+  const simulation_api_schema::UpdateEntityStatusRequest & request, SimulatorStatuses & statuses)
+  -> void
+{
+  for (const auto & delta : request.status_delta()) {
+    decoder.decode(delta, statuses[decoder.name(delta)]);
+  }
+}
+
+TEST(EntityStatusDelta, FirstSendCarriesName)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  SimulatorStatuses statuses;
+  const auto request = send(encoder, {{0, makeStatus("npc", 1.0)}});
+  ASSERT_EQ(request.status_delta_size(), 1);
+  EXPECT_EQ(request.status_delta(0).id(), static_cast<std::uint64_t>(0));
+  EXPECT_EQ(request.status_delta(0).name(), "npc");
+  EXPECT_TRUE(request.status_delta(0).has_type());
+  EXPECT_TRUE(request.status_delta(0).has_action_status());
+  EXPECT_TRUE(request.status_delta(0).has_pose());
+  receive(decoder, request, statuses);
+  ASSERT_EQ(statuses.count("npc"), static_cast<std::size_t>(1));
+  EXPECT_EQ(statuses["npc"].type().type(), traffic_simulator_msgs::EntityType::VEHICLE);
+  EXPECT_DOUBLE_EQ(statuses["npc"].pose().position().x(), 1.0);
+  EXPECT_DOUBLE_EQ(statuses["npc"].action_status().twist().linear().x(), 1.0);
+  EXPECT_EQ(encoder.name(0), "npc");
+}
+
+TEST(EntityStatusDelta, UnchangedEntityIsOmitted)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  SimulatorStatuses statuses;
+  receive(
+    decoder, send(encoder, {{0, makeStatus("npc0", 1.0)}, {1, makeStatus("npc1", 2.0)}}), statuses);
+
+  const auto request = send(encoder, {{0, makeStatus("npc0", 1.0)}, {1, makeStatus("npc1", 3.0)}});
+  ASSERT_EQ(request.status_delta_size(), 1);
+  EXPECT_EQ(request.status_delta(0).id(), static_cast<std::uint64_t>(1));
+  EXPECT_TRUE(request.status_delta(0).name().empty());
+  EXPECT_FALSE(request.status_delta(0).has_type());
+  EXPECT_FALSE(request.status_delta(0).has_action_status());
+  EXPECT_TRUE(request.status_delta(0).has_pose());
+  receive(decoder, request, statuses);
+  EXPECT_DOUBLE_EQ(statuses["npc0"].pose().position().x(), 1.0);
+  EXPECT_DOUBLE_EQ(statuses["npc1"].pose().position().x(), 3.0);
+  EXPECT_DOUBLE_EQ(statuses["npc1"].action_status().twist().linear().x(), 1.0);
+
+  /// @note Omitted entities are still known by the id in the response.
+  EXPECT_EQ(encoder.name(0), "npc0");
+  EXPECT_EQ(encoder.name(1), "npc1");
+}
+
+TEST(EntityStatusDelta, FullEntityIsAlwaysSent)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  send(encoder, {{0, makeStatus("ego", 1.0)}});
+  simulation_api_schema::EntityStatusDelta delta;
+  EXPECT_TRUE(encoder.encode(0, makeStatus("ego", 1.0), true, delta));
+  EXPECT_TRUE(delta.name().empty());
+  EXPECT_TRUE(delta.has_type());
+  EXPECT_TRUE(delta.has_action_status());
+  EXPECT_TRUE(delta.has_pose());
+}
+
+TEST(EntityStatusDelta, Respawn)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  SimulatorStatuses statuses;
+  receive(decoder, send(encoder, {{0, makeStatus("npc", 1.0)}}), statuses);
+
+  /// @note Despawn, which the simulator is told by DespawnEntityRequest.
+  EXPECT_EQ(send(encoder, {}).status_delta_size(), 0);
+  decoder.erase("npc");
+  statuses.erase("npc");
+  EXPECT_THROW(encoder.name(0), common::SimulationError);
+  simulation_api_schema::EntityStatusDelta stale;
+  stale.set_id(0);
+  EXPECT_THROW(decoder.name(stale), common::SimulationError);
+
+  /// @note Respawn with the same name and the same status, but a new id.
+  const auto request = send(encoder, {{1, makeStatus("npc", 1.0)}});
+  ASSERT_EQ(request.status_delta_size(), 1);
+  EXPECT_EQ(request.status_delta(0).id(), static_cast<std::uint64_t>(1));
+  EXPECT_EQ(request.status_delta(0).name(), "npc");
+  receive(decoder, request, statuses);
+  EXPECT_DOUBLE_EQ(statuses["npc"].pose().position().x(), 1.0);
+  EXPECT_EQ(encoder.name(1), "npc");
+}
+
+TEST(EntityStatusDelta, LostFrame)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  SimulatorStatuses statuses;
+  receive(decoder, send(encoder, {{0, makeStatus("npc", 1.0)}}), statuses);
+
+  /// @note The frame moving the entity fails to reach the simulator, so it is not flushed.
+  simulation_api_schema::EntityStatusDelta lost;
+  ASSERT_TRUE(encoder.encode(0, makeStatus("npc", 2.0), false, lost));
+  encoder.reset();
+
+  /// @note The entity is back at the first position, which is not the same as the simulator has.
+  const auto request = send(encoder, {{0, makeStatus("npc", 1.0)}});
+  ASSERT_EQ(request.status_delta_size(), 1);
+  EXPECT_EQ(request.status_delta(0).name(), "npc");
+  EXPECT_TRUE(request.status_delta(0).has_pose());
+  receive(decoder, request, statuses);
+  EXPECT_DOUBLE_EQ(statuses["npc"].pose().position().x(), 1.0);
+}
+
+TEST(EntityStatusDelta, Clear)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_interface::EntityStatusDeltaDecoder decoder;
+  SimulatorStatuses statuses;
+  receive(decoder, send(encoder, {{0, makeStatus("npc", 1.0)}}), statuses);
+
+  /// @note The simulator is initialized again, and ids of the previous scenario are not mapped.
+  decoder.clear();
+  simulation_api_schema::EntityStatusDelta stale;
+  stale.set_id(0);
+  EXPECT_THROW(decoder.name(stale), common::SimulationError);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,247 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <vector>
+
+namespace
+{
+enum class Map { KASHIWANOHA, GRID };
+
+struct Scenario
+{
+  std::unique_ptr<hdmap_utils::HdMapUtils> hdmap_utils;
+
+  lanelet::Id from;
+
+  /// @note A lanelet far from the lanelet "from", reachable with lane changes.
+  lanelet::Id to;
+
+  /// @note A lanelet on the left side of the lanelet "from".
+  lanelet::Id left;
+
+  std::vector<geometry_msgs::msg::Pose> poses;
+};
+
+auto makeOrigin() -> geographic_msgs::msg::GeoPoint
+{
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.903;
+  origin.longitude = 139.933;
+  return origin;
+}
+
+/**
+ * @brief Write a synthetic map of straight lanes to a temporary file.
+ * @note  Lanelet (lane, segment) is 20 m long and 3.5 m wide, followed by (lane, segment + 1) and
+ *        separated from (lane + 1, segment) by a dashed line, so lane changes are allowed
+ *        everywhere.
+ */
+auto makeGridMap(const lanelet::Id lanes, const lanelet::Id segments) -> boost::filesystem::path
+{
+  constexpr double segment_length = 20.0;
+  constexpr double lane_width = 3.5;
+  constexpr double meters_per_degree = 111319.49;
+  const auto origin = makeOrigin();
+  const auto node_id = [&](const lanelet::Id bound, const lanelet::Id column) {
+    return 1 + bound * (segments + 1) + column;
+  };
+  const auto way_id = [&](const lanelet::Id bound, const lanelet::Id segment) {
+    return node_id(lanes + 1, 0) + bound * segments + segment;
+  };
+  const auto lanelet_id = [&](const lanelet::Id lane, const lanelet::Id segment) {
+    return way_id(lanes + 1, 0) + lane * segments + segment;
+  };
+
+  const auto path = boost::filesystem::temp_directory_path() / "scenario_simulator_v2" /
+                    "benchmark" /
+                    ("grid_map_" + std::to_string(lanes) + "x" + std::to_string(segments) + ".osm");
+  boost::filesystem::create_directories(path.parent_path());
+  std::ofstream file(path.string());
+  file << std::setprecision(12);
+  file << "<?xml version='1.0' encoding='UTF-8'?>\n<osm version='0.6'>\n";
+  for (lanelet::Id bound = 0; bound <= lanes; ++bound) {
+    for (lanelet::Id column = 0; column <= segments; ++column) {
+      file << "  <node id='" << node_id(bound, column) << "' version='1' lat='"
+           << origin.latitude + bound * lane_width / meters_per_degree << "' lon='"
+           << origin.longitude + column * segment_length /
+                                   (meters_per_degree * std::cos(origin.latitude * M_PI / 180.0))
+           << "'>\n    <tag k='ele' v='0' />\n  </node>\n";
+    }
+  }
+  for (lanelet::Id bound = 0; bound <= lanes; ++bound) {
+    const auto subtype = bound == 0 or bound == lanes ? "solid" : "dashed";
+    for (lanelet::Id segment = 0; segment < segments; ++segment) {
+      file << "  <way id='" << way_id(bound, segment) << "' version='1'>\n"
+           << "    <nd ref='" << node_id(bound, segment) << "' />\n"
+           << "    <nd ref='" << node_id(bound, segment + 1) << "' />\n"
+           << "    <tag k='type' v='line_thin' />\n"
+           << "    <tag k='subtype' v='" << subtype << "' />\n  </way>\n";
+    }
+  }
+  for (lanelet::Id lane = 0; lane < lanes; ++lane) {
+    for (lanelet::Id segment = 0; segment < segments; ++segment) {
+      file << "  <relation id='" << lanelet_id(lane, segment) << "' version='1'>\n"
+           << "    <member type='way' role='left' ref='" << way_id(lane + 1, segment) << "' />\n"
+           << "    <member type='way' role='right' ref='" << way_id(lane, segment) << "' />\n"
+           << "    <tag k='type' v='lanelet' />\n"
+           << "    <tag k='subtype' v='road' />\n"
+           << "    <tag k='speed_limit' v='50' />\n"
+           << "    <tag k='location' v='urban' />\n"
+           << "    <tag k='one_way' v='yes' />\n  </relation>\n";
+    }
+  }
+  file << "</osm>\n";
+  return path;
+}
+
+auto makeScenario(const Map map) -> Scenario
+{
+  Scenario scenario;
+  switch (map) {
+    case Map::KASHIWANOHA:
+      scenario.hdmap_utils = std::make_unique<hdmap_utils::HdMapUtils>(
+        ament_index_cpp::get_package_share_directory("kashiwanoha_map") + "/map/lanelet2_map.osm",
+        makeOrigin());
+      scenario.from = 34513;
+      scenario.to = scenario.hdmap_utils->getFollowingLanelets(scenario.from, 300.0).back();
+      break;
+    case Map::GRID: {
+      constexpr lanelet::Id lanes = 10;
+      constexpr lanelet::Id segments = 200;
+      scenario.hdmap_utils =
+        std::make_unique<hdmap_utils::HdMapUtils>(makeGridMap(lanes, segments), makeOrigin());
+      /// @note The first segment of the rightmost lane and the last segment of the leftmost lane.
+      const auto ids = scenario.hdmap_utils->getLaneletIds();
+      scenario.from = *std::min_element(ids.begin(), ids.end());
+      scenario.to = *std::max_element(ids.begin(), ids.end());
+    } break;
+  }
+  traffic_simulator_msgs::msg::EntityType type;
+  type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  const auto left_ids = scenario.hdmap_utils->getLeftLaneletIds(scenario.from, type, false);
+  scenario.left = left_ids.empty() ? scenario.from : left_ids.front();
+  /// @note Poses at the middle of the lanelets, to be matched by toLaneletPose.
+  for (const auto id : scenario.hdmap_utils->getLaneletIds()) {
+    if (scenario.poses.size() == 256) {
+      break;
+    }
+    scenario.poses.push_back(
+      scenario.hdmap_utils
+        ->toMapPose(traffic_simulator::helper::constructLaneletPose(
+          id, scenario.hdmap_utils->getLaneletLength(id) * 0.5, 0.0))
+        .pose);
+  }
+  return scenario;
+}
+
+/// @note Maps are loaded once and shared by all benchmarks, since loading takes seconds.
+auto getScenario(const Map map) -> const Scenario &
+{
+  static const auto kashiwanoha = makeScenario(Map::KASHIWANOHA);
+  if (map == Map::KASHIWANOHA) {
+    return kashiwanoha;
+  }
+  static const auto grid = makeScenario(Map::GRID);
+  return grid;
+}
+
+auto makeLaneletPose(const lanelet::Id lanelet_id, const double s = 1.0)
+  -> traffic_simulator_msgs::msg::LaneletPose
+{
+  return traffic_simulator::helper::constructLaneletPose(lanelet_id, s, 0.0);
+}
+}  // namespace
+
+static void ToLaneletPose(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      scenario.hdmap_utils->toLaneletPose(scenario.poses[i++ % scenario.poses.size()], false));
+  }
+}
+BENCHMARK_CAPTURE(ToLaneletPose, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(ToLaneletPose, grid_map, Map::GRID);
+
+/// @note Routes are cached by HdMapUtils, so this measures the lookup after the first iteration.
+static void GetRoute(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scenario.hdmap_utils->getRoute(scenario.from, scenario.to, true));
+  }
+}
+BENCHMARK_CAPTURE(GetRoute, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(GetRoute, grid_map, Map::GRID);
+
+static void GetLongitudinalDistance(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  const auto from = makeLaneletPose(scenario.from);
+  const auto to = makeLaneletPose(scenario.to);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scenario.hdmap_utils->getLongitudinalDistance(from, to, true));
+  }
+}
+BENCHMARK_CAPTURE(GetLongitudinalDistance, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(GetLongitudinalDistance, grid_map, Map::GRID);
+
+static void GetLaneChangeTrajectory(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  const auto from = makeLaneletPose(scenario.from);
+  const traffic_simulator::lane_change::Parameter parameter(
+    traffic_simulator::lane_change::AbsoluteTarget(scenario.left));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scenario.hdmap_utils->getLaneChangeTrajectory(from, parameter));
+  }
+}
+BENCHMARK_CAPTURE(GetLaneChangeTrajectory, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(GetLaneChangeTrajectory, grid_map, Map::GRID);
+
+static void GetFollowingLanelets(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scenario.hdmap_utils->getFollowingLanelets(scenario.from, 100.0));
+  }
+}
+BENCHMARK_CAPTURE(GetFollowingLanelets, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(GetFollowingLanelets, grid_map, Map::GRID);
+
+static void GetConflictingLaneIds(benchmark::State & state, const Map map)
+{
+  const auto & scenario = getScenario(map);
+  const auto ids = scenario.hdmap_utils->getLaneletIds();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scenario.hdmap_utils->getConflictingLaneIds(ids));
+  }
+}
+BENCHMARK_CAPTURE(GetConflictingLaneIds, kashiwanoha_map, Map::KASHIWANOHA);
+BENCHMARK_CAPTURE(GetConflictingLaneIds, grid_map, Map::GRID);
+
+BENCHMARK_MAIN();
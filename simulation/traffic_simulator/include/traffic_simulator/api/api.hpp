@@ -26,6 +26,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <rosgraph_msgs/msg/clock.hpp>
 #include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
 #include <std_msgs/msg/float64.hpp>
 #include <stdexcept>
@@ -67,7 +68,10 @@ public:
   : configuration(configuration),
     entity_manager_ptr_(std::make_shared<entity::EntityManager>(node, configuration)),
     traffic_controller_ptr_(std::make_shared<traffic::TrafficController>(
-      entity_manager_ptr_->getHdmapUtils(), [this]() { return API::getEntityNames(); },
+      entity_manager_ptr_->getHdmapUtils(),
+      [this](const auto & center, const auto radius) {
+        return entity_manager_ptr_->getEntityNamesInRange(center, radius);
+      },
       [this](const auto & name) { return API::getMapPose(name); },
       [this](const auto & name) { return API::despawn(name); }, configuration.auto_sink)),
     clock_pub_(rclcpp::create_publisher<rosgraph_msgs::msg::Clock>(
@@ -91,7 +95,7 @@ public:
       })),
     clock_(node->get_parameter("use_sim_time").as_bool(), std::forward<decltype(xs)>(xs)...),
     zeromq_client_(
-      simulation_interface::protocol, configuration.simulator_host, getZMQSocketPort(*node))
+      getZMQTransportProtocol(*node), configuration.simulator_host, getZMQSocketPort(*node))
   {
     setVerbose(configuration.verbose);
 
@@ -99,6 +103,8 @@ public:
       simulation_api_schema::InitializeRequest request;
       request.set_initialize_time(clock_.getCurrentSimulationTime());
       request.set_lanelet2_map_path(configuration.lanelet2_map_path().string());
+      request.set_prebuilt_map_path(
+        entity_manager_ptr_->getHdmapUtils()->getPrebuiltMapPath().string());
       request.set_realtime_factor(clock_.realtime_factor);
       request.set_step_time(clock_.getStepTime());
       simulation_interface::toProto(
@@ -116,6 +122,16 @@ public:
     return node.get_parameter("port").as_int();
   }
 
+  template <typename Node>
+  auto getZMQTransportProtocol(Node & node) -> simulation_interface::TransportProtocol
+  {
+    if (!node.has_parameter("transport_protocol"))
+      node.declare_parameter(
+        "transport_protocol", simulation_interface::enumToString(simulation_interface::protocol));
+    return simulation_interface::toTransportProtocol(
+      node.get_parameter("transport_protocol").as_string());
+  }
+
   void closeZMQConnection() { zeromq_client_.closeConnection(); }
 
   void setVerbose(const bool verbose);
@@ -254,7 +270,7 @@ public:
   bool attachLidarSensor(const simulation_api_schema::LidarConfiguration &);
   bool attachLidarSensor(
     const std::string &, const double lidar_sensor_delay,
-    const helper::LidarType = helper::LidarType::VLP16);
+    const helper::LidarType = helper::LidarType::VLP16, const bool static_environment = false);
 
   bool attachDetectionSensor(const simulation_api_schema::DetectionSensorConfiguration &);
   bool attachDetectionSensor(
@@ -395,11 +411,14 @@ public:
     -> std::optional<CanonicalizedLaneletPose>;
 
 private:
-  bool updateTimeInSim();
+  auto makeUpdateFrameRequest() -> simulation_api_schema::UpdateFrameRequest;
+
+  auto makeUpdateEntityStatusRequest() -> simulation_api_schema::UpdateEntityStatusRequest;
 
-  bool updateEntitiesStatusInSim();
+  auto applyUpdateEntityStatusResponse(const simulation_api_schema::UpdateEntityStatusResponse &)
+    -> void;
 
-  bool updateTrafficLightsInSim();
+  bool updateFrameInSim();
 
   const Configuration configuration;
 
@@ -416,6 +435,9 @@ private:
   SimulationClock clock_;
 
   zeromq::MultiClient zeromq_client_;
+
+  /// @note Keyed by EntityManager::getEntityId, which is never reused for another entity.
+  simulation_interface::EntityStatusDeltaEncoder entity_status_delta_encoder_;
 };
 }  // namespace traffic_simulator
 
@@ -20,9 +20,11 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <cstddef>
 #include <iomanip>
 #include <scenario_simulator_exception/exception.hpp>
 #include <string>
+#include <traffic_simulator/hdmap_utils/route_cache_capacity.hpp>
 
 namespace traffic_simulator
 {
@@ -44,6 +46,25 @@ struct Configuration
 
   double v2i_traffic_light_publish_rate = 10.0;
 
+  /*
+   *  Number of threads updating entities in EntityManager::update. Entities other than ego are
+   *  updated in parallel if more than 1 is given. Results do not depend on this value, since every
+   *  entity reads the statuses of other entities from the previous snapshot.
+   */
+  std::size_t entity_update_thread_count = 1;
+
+  /*
+   *  If true, UpdateEntityStatusRequest sends only entities and fields changed since the last
+   *  frame, keyed by numeric ids instead of names. The simulator has to support the delta mode.
+   */
+  bool delta_encoded_entity_status = false;
+
+  /*
+   *  Maximum number of routes HdMapUtils caches. 0 means the cache never evicts, which is only
+   *  safe if the scenario asks for routes between a bounded set of lanelets.
+   */
+  std::size_t route_cache_capacity = hdmap_utils::default_route_cache_capacity;
+
   /* ---- NOTE -----------------------------------------------------------------
    *
    *  This setting comes from the argument of the same name (= `map_path`) in
@@ -33,8 +33,7 @@
 
 namespace entity_behavior
 {
-using EntityStatusDict =
-  std::unordered_map<std::string, traffic_simulator::CanonicalizedEntityStatus>;
+using EntityStatusDict = traffic_simulator::OtherEntityStatus;
 
 class BehaviorPluginBase
 {
@@ -0,0 +1,36 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
+#define TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
+
+#include <memory>
+#include <pluginlib/class_loader.hpp>
+#include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+
+namespace entity_behavior
+{
+using BehaviorPluginLoader = pluginlib::ClassLoader<BehaviorPluginBase>;
+
+/**
+ * @brief Returns the class loader of behavior plugins shared by all entities.
+ * @note  Constructing a class loader scans the plugin manifests of all packages, which is too slow
+ *        to do at every spawn. Entities hold the returned loader, since plugin instances must not
+ *        outlive the loader that created them. The loader is destroyed with the last entity holding
+ *        it, instead of at static destruction after the plugin libraries may have been unloaded.
+ */
+auto getBehaviorPluginLoader() -> std::shared_ptr<BehaviorPluginLoader>;
+}  // namespace entity_behavior
+
+#endif  // TRAFFIC_SIMULATOR__BEHAVIOR__BEHAVIOR_PLUGIN_LOADER_HPP_
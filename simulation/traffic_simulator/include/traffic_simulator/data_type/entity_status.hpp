@@ -15,14 +15,23 @@
 #ifndef TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATUS_HPP_
 #define TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATUS_HPP_
 
+#include <boost/iterator/filter_iterator.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <unordered_map>
+#include <vector>
 
 namespace traffic_simulator
 {
 using EntityStatus = traffic_simulator_msgs::msg::EntityStatus;
 
+class EntityBroadphase;
+
 inline namespace entity_status
 {
 class CanonicalizedEntityStatus
@@ -67,6 +76,90 @@ private:
     const lanelet::Ids & route_lanelets) -> EntityStatus;
   EntityStatus entity_status_;
 };
+
+/**
+ * @brief Statuses of all entities at some point of a frame.
+ * @note  Snapshots are immutable once taken and shared by every entity, instead of copying the
+ *        statuses into each entity.
+ */
+struct EntityStatusSnapshot
+{
+  /// @note Incremented every time a new snapshot is taken.
+  std::size_t version = 0;
+
+  std::unordered_map<std::string, CanonicalizedEntityStatus> statuses;
+
+  /// @note Built at the first call instead of at every snapshot, and shared by all entities.
+  auto getBroadphase() const -> const EntityBroadphase &;
+
+private:
+  mutable std::once_flag broadphase_once_flag_;
+
+  mutable std::shared_ptr<const EntityBroadphase> broadphase_;
+};
+
+/**
+ * @brief Read-only view of an EntityStatusSnapshot without one entity, i.e. the statuses of other
+ *        entities as seen from that entity.
+ * @note  Copying a view copies the shared pointer to the snapshot and the excluded name, not the
+ *        statuses. Iterators and references point into the snapshot, so they stay valid as long as
+ *        the snapshot is shared by any view, even after the view they are taken from is moved.
+ */
+class OtherEntityStatus
+{
+  using Statuses = std::unordered_map<std::string, CanonicalizedEntityStatus>;
+
+  /// @note Compares addresses of the elements of the snapshot, which do not move with the view.
+  struct IsOtherEntity
+  {
+    const Statuses::value_type * excluded_status;
+
+    auto operator()(const Statuses::value_type & value) const -> bool
+    {
+      return &value != excluded_status;
+    }
+  };
+
+public:
+  using const_iterator = boost::filter_iterator<IsOtherEntity, Statuses::const_iterator>;
+
+  OtherEntityStatus() = default;
+
+  explicit OtherEntityStatus(
+    const std::shared_ptr<const EntityStatusSnapshot> &, const std::string & excluded_name);
+
+  auto at(const std::string & name) const -> const CanonicalizedEntityStatus &;
+
+  auto begin() const -> const_iterator;
+
+  auto count(const std::string & name) const -> std::size_t;
+
+  auto empty() const -> bool;
+
+  auto end() const -> const_iterator;
+
+  auto find(const std::string & name) const -> const_iterator;
+
+  /// @note Broadphase queries of EntityBroadphase, without the excluded entity.
+  auto getEntityNamesInRange(const geometry_msgs::msg::Point & center, double radius) const
+    -> std::vector<std::string>;
+
+  auto getEntityNamesOnLanelets(const lanelet::Ids &) const -> std::vector<std::string>;
+
+  auto size() const -> std::size_t;
+
+  auto version() const -> std::size_t;
+
+private:
+  auto statuses() const -> const Statuses &;
+
+  std::shared_ptr<const EntityStatusSnapshot> snapshot_;
+
+  std::string excluded_name_;
+
+  /// @note nullptr if the excluded entity is not in the snapshot.
+  const Statuses::value_type * excluded_status_ = nullptr;
+};
 }  // namespace entity_status
 
 bool isSameLaneletId(const CanonicalizedEntityStatus &, const CanonicalizedEntityStatus &);
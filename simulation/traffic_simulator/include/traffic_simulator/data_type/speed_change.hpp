@@ -60,8 +60,7 @@ struct RelativeTargetSpeed
   {
   }
   double getAbsoluteValue(
-    const CanonicalizedEntityStatus & status,
-    const std::unordered_map<std::string, CanonicalizedEntityStatus> & other_status) const;
+    const CanonicalizedEntityStatus & status, const OtherEntityStatus & other_status) const;
   std::string reference_entity_name;
   Type type;
   double value;
@@ -187,7 +187,7 @@ public:
 
   virtual void setBehaviorParameter(const traffic_simulator_msgs::msg::BehaviorParameter &) = 0;
 
-  /*   */ void setOtherStatus(const std::unordered_map<std::string, CanonicalizedEntityStatus> &);
+  /*   */ void setOtherStatus(const std::shared_ptr<const EntityStatusSnapshot> &);
 
   virtual auto setStatus(const CanonicalizedEntityStatus &) -> void;
 
@@ -241,7 +241,7 @@ protected:
   double stand_still_duration_ = 0.0;
   double traveled_distance_ = 0.0;
 
-  std::unordered_map<std::string, CanonicalizedEntityStatus> other_status_;
+  OtherEntityStatus other_status_;
 
   std::optional<double> target_speed_;
   traffic_simulator::job::JobList job_list_;
@@ -20,6 +20,7 @@
 #include <tf2_ros/transform_broadcaster.h>
 
 #include <autoware_perception_msgs/msg/traffic_signal_array.hpp>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <rclcpp/node_interfaces/get_node_topics_interface.hpp>
@@ -42,6 +43,7 @@
 #include <traffic_simulator/traffic_lights/configurable_rate_updater.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_marker_publisher.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_publisher.hpp>
+#include <traffic_simulator/utils/worker_pool.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status_with_trajectory_array.hpp>
@@ -99,6 +101,24 @@ class EntityManager
 
   bool npc_logic_started_;
 
+  std::size_t entity_status_snapshot_version_ = 0;
+
+  /// @note Ids of entities sent to the simulator, assigned at spawn and never reused.
+  std::unordered_map<std::string, std::uint64_t> entity_ids_;
+
+  std::uint64_t next_entity_id_ = 0;
+
+  /// @note The latest snapshot, and entities spawned after it, for getEntityNamesInRange.
+  std::shared_ptr<const EntityStatusSnapshot> entity_status_snapshot_;
+
+  std::vector<std::string> entity_names_spawned_after_snapshot_;
+
+  /// @note Only when Configuration::entity_update_thread_count is more than 1.
+  const std::unique_ptr<WorkerPool> entity_update_worker_pool_ =
+    configuration.entity_update_thread_count > 1
+      ? std::make_unique<WorkerPool>(configuration.entity_update_thread_count)
+      : nullptr;
+
   using EntityStatusWithTrajectoryArray =
     traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray;
   const rclcpp::Publisher<EntityStatusWithTrajectoryArray>::SharedPtr entity_status_array_pub_ptr_;
@@ -120,6 +140,9 @@ class EntityManager
   const std::shared_ptr<TrafficLightPublisherBase> v2i_traffic_light_publisher_ptr_;
   ConfigurableRateUpdater v2i_traffic_light_updater_, conventional_traffic_light_updater_;
 
+  /// @note Version of the conventional traffic lights last sent to the simulator.
+  std::optional<std::size_t> sent_conventional_traffic_lights_version_;
+
 public:
   template <typename Node>
   auto getOrigin(Node & node) const
@@ -171,7 +194,7 @@ public:
       node, "lanelet/marker", LaneletMarkerQoS(),
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     hdmap_utils_ptr_(std::make_shared<hdmap_utils::HdMapUtils>(
-      configuration.lanelet2_map_path(), getOrigin(*node))),
+      configuration.lanelet2_map_path(), getOrigin(*node), configuration.route_cache_capacity)),
     markers_raw_(hdmap_utils_ptr_->generateMarker()),
     conventional_traffic_light_manager_ptr_(
       std::make_shared<TrafficLightManager>(hdmap_utils_ptr_)),
@@ -223,6 +246,8 @@ public:
 
   auto generateUpdateRequestForConventionalTrafficLights()
   {
+    sent_conventional_traffic_lights_version_ =
+      conventional_traffic_light_manager_ptr_->getVersion();
     return conventional_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest();
   }
 
@@ -239,7 +264,7 @@ public:
   auto setConventionalTrafficLightConfidence(lanelet::Id id, double confidence) -> void
   {
     for (auto & traffic_light : conventional_traffic_light_manager_ptr_->getTrafficLights(id)) {
-      traffic_light.get().confidence = confidence;
+      traffic_light.get().setConfidence(confidence);
     }
   }
 
@@ -326,6 +351,7 @@ public:
 
   visualization_msgs::msg::MarkerArray makeDebugMarker() const;
 
+  /// @note Whether conventional traffic lights changed since they were generated as a request last.
   bool trafficLightsChanged();
 
   void requestSpeedChange(const std::string & name, double target_speed, bool continuous);
@@ -360,11 +386,25 @@ public:
 
   auto getEntityNames() const -> const std::vector<std::string>;
 
+  /**
+   * @brief Candidates of entities within the radius, from the broadphase of the latest snapshot.
+   * @note  Entities moved since the latest snapshot (other than by spawning) are not taken into
+   *        account, so callers have to check the current poses of the candidates.
+   */
+  auto getEntityNamesInRange(const geometry_msgs::msg::Point & center, double radius) const
+    -> std::vector<std::string>;
+
+  /// @note Id of the entity, which another entity spawned later with the same name does not get.
+  auto getEntityId(const std::string & name) const -> std::uint64_t;
+
   auto getEntity(const std::string & name) const
     -> std::shared_ptr<traffic_simulator::entity::EntityBase>;
 
   auto getEntityStatus(const std::string & name) const -> CanonicalizedEntityStatus;
 
+  /// @note Statuses of all entities, to be sent to the simulator.
+  auto getEntityStatuses() const -> std::vector<EntityStatus>;
+
   auto getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &;
 
   auto getNumberOfEgo() const -> std::size_t;
@@ -442,6 +482,13 @@ public:
 
   auto setEntityStatus(const std::string & name, const CanonicalizedEntityStatus &) -> void;
 
+  /**
+   * @brief Set statuses of entities other than the ego, received from the simulator.
+   * @note  Entities moved by the simulator are matched to lanelets again in one batch, while the
+   *        others keep their lanelet poses.
+   */
+  auto setEntityStatuses(const std::vector<EntityStatus> &) -> void;
+
   void setVerbose(const bool verbose);
 
   template <typename Entity, typename Pose, typename Parameters, typename... Ts>
@@ -525,6 +572,8 @@ public:
                   name, makeEntityStatus(), hdmap_utils_ptr_, parameters,
                   std::forward<decltype(xs)>(xs)...));
         success) {
+      entity_ids_.emplace(name, next_entity_id_++);
+      entity_names_spawned_after_snapshot_.push_back(name);
       // FIXME: this ignores V2I traffic lights
       iter->second->setTrafficLightManager(conventional_traffic_light_manager_ptr_);
       if (npc_logic_started_ && not is<EgoEntity>(name)) {
@@ -40,8 +40,11 @@ public:
 
   auto getEntityType() const -> const traffic_simulator_msgs::msg::EntityType & override
   {
-    static traffic_simulator_msgs::msg::EntityType type;
-    type.type = traffic_simulator_msgs::msg::EntityType::MISC_OBJECT;
+    static const auto type = []() {
+      traffic_simulator_msgs::msg::EntityType type;
+      type.type = traffic_simulator_msgs::msg::EntityType::MISC_OBJECT;
+      return type;
+    }();
     return type;
   }
 
@@ -17,10 +17,10 @@
 
 #include <memory>
 #include <optional>
-#include <pluginlib/class_loader.hpp>
 #include <pugixml.hpp>
 #include <string>
 #include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <traffic_simulator/behavior/behavior_plugin_loader.hpp>
 #include <traffic_simulator/behavior/route_planner.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <traffic_simulator_msgs/msg/pedestrian_parameters.hpp>
@@ -124,7 +124,7 @@ public:
   const traffic_simulator_msgs::msg::PedestrianParameters pedestrian_parameters;
 
 private:
-  pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase> loader_;
+  const std::shared_ptr<entity_behavior::BehaviorPluginLoader> loader_;
   const std::shared_ptr<entity_behavior::BehaviorPluginBase> behavior_plugin_ptr_;
   traffic_simulator::RoutePlanner route_planner_;
 };
@@ -17,11 +17,11 @@
 
 #include <memory>
 #include <optional>
-#include <pluginlib/class_loader.hpp>
 #include <pugixml.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <string>
 #include <traffic_simulator/behavior/behavior_plugin_base.hpp>
+#include <traffic_simulator/behavior/behavior_plugin_loader.hpp>
 #include <traffic_simulator/behavior/route_planner.hpp>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
@@ -129,7 +129,7 @@ public:
   const traffic_simulator_msgs::msg::VehicleParameters vehicle_parameters;
 
 private:
-  pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase> loader_;
+  const std::shared_ptr<entity_behavior::BehaviorPluginLoader> loader_;
 
   const std::shared_ptr<entity_behavior::BehaviorPluginBase> behavior_plugin_ptr_;
 
@@ -15,12 +15,17 @@
 #ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 #define TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 
+#include <array>
+#include <cstddef>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <scenario_simulator_exception/exception.hpp>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace std
@@ -44,113 +49,189 @@ public:
 
 namespace hdmap_utils
 {
-class RouteCache
+/**
+ * @brief Thread safe key-value cache, which evicts the least recently used entry when full.
+ * @note  Entries are split into shards by the hash of the key and every shard has its own mutex,
+ *        so queries for different keys rarely wait for each other. Lookup and update of the
+ *        recently used order are done under a single lock.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
 {
 public:
-  auto exists(lanelet::Id from, lanelet::Id to, bool allow_lane_change)
+  /// @param capacity Maximum number of entries. 0 means the cache never evicts.
+  explicit LruCache(const std::size_t capacity = 0)
+  : capacity_per_shard_(capacity == 0 ? 0 : (capacity + shard_count - 1) / shard_count)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::tuple<lanelet::Id, lanelet::Id, bool> key = {from, to, allow_lane_change};
-    return data_.find(key) != data_.end();
   }
 
-  auto getRoute(const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change)
-    -> decltype(auto)
+  auto find(const Key & key) -> std::optional<Value>
   {
-    if (!exists(from, to, allow_lane_change)) {
-      THROW_SIMULATION_ERROR(
-        "route from : ", from, " to : ", to, (allow_lane_change ? " with" : " without"),
-        " lane change does not exists on route cache.");
-    } else {
-      std::lock_guard<std::mutex> lock(mutex_);
-      return data_.at({from, to, allow_lane_change});
+    auto & shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (const auto iter = shard.index.find(key); iter != shard.index.end()) {
+      shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+      return iter->second->second;
+    }
+    return std::nullopt;
+  }
+
+  auto insert(const Key & key, const Value & value) -> void
+  {
+    auto & shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (const auto iter = shard.index.find(key); iter != shard.index.end()) {
+      iter->second->second = value;
+      shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+      return;
+    }
+    shard.entries.emplace_front(key, value);
+    shard.index.emplace(key, shard.entries.begin());
+    if (capacity_per_shard_ != 0 and shard.entries.size() > capacity_per_shard_) {
+      shard.index.erase(shard.entries.back().first);
+      shard.entries.pop_back();
     }
   }
 
+private:
+  static constexpr std::size_t shard_count = 16;
+
+  struct Shard
+  {
+    std::mutex mutex;
+
+    /// @note Sorted from the most recently used to the least recently used.
+    std::list<std::pair<Key, Value>> entries;
+
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+  };
+
+  auto getShard(const Key & key) -> Shard & { return shards_[Hash{}(key) % shard_count]; }
+
+  const std::size_t capacity_per_shard_;
+
+  std::array<Shard, shard_count> shards_;
+};
+
+class RouteCache
+{
+public:
+  explicit RouteCache(const std::size_t capacity = 0) : data_(capacity) {}
+
+  auto getRoute(const lanelet::Id from, const lanelet::Id to, const bool allow_lane_change)
+    -> std::optional<lanelet::Ids>
+  {
+    return data_.find({from, to, allow_lane_change});
+  }
+
   auto appendData(
     lanelet::Id from, lanelet::Id to, const bool allow_lane_change, const lanelet::Ids & route)
     -> void
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    data_[{from, to, allow_lane_change}] = route;
+    data_.insert({from, to, allow_lane_change}, route);
   }
 
 private:
-  std::unordered_map<std::tuple<lanelet::Id, lanelet::Id, bool>, lanelet::Ids> data_;
-
-  std::mutex mutex_;
+  LruCache<std::tuple<lanelet::Id, lanelet::Id, bool>, lanelet::Ids> data_;
 };
 
 class CenterPointsCache
 {
 public:
-  auto exists(lanelet::Id lanelet_id) -> bool
+  explicit CenterPointsCache(const std::size_t capacity = 0) : splines_(capacity) {}
+
+  /// @note The center points are the control points of the spline.
+  auto getCenterPointsSpline(const lanelet::Id lanelet_id)
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.find(lanelet_id) != data_.end();
+    return splines_.find(lanelet_id).value_or(nullptr);
   }
 
-  auto getCenterPoints(lanelet::Id lanelet_id) -> decltype(auto)
+  auto appendData(lanelet::Id lanelet_id, const std::vector<geometry_msgs::msg::Point> & route)
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.at(lanelet_id);
+    const auto spline = std::make_shared<math::geometry::CatmullRomSpline>(route);
+    splines_.insert(lanelet_id, spline);
+    return spline;
   }
 
-  auto getCenterPointsSpline(lanelet::Id lanelet_id) -> decltype(auto)
+private:
+  LruCache<lanelet::Id, std::shared_ptr<math::geometry::CatmullRomSpline>> splines_;
+};
+
+class LaneletLengthCache
+{
+public:
+  explicit LaneletLengthCache(const std::size_t capacity = 0) : data_(capacity) {}
+
+  auto getLength(const lanelet::Id lanelet_id) -> std::optional<double>
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    return splines_[lanelet_id];
+    return data_.find(lanelet_id);
   }
 
-  auto appendData(lanelet::Id lanelet_id, const std::vector<geometry_msgs::msg::Point> & route)
+  auto appendData(lanelet::Id lanelet_id, double length) -> void
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    data_[lanelet_id] = route;
-    splines_[lanelet_id] = std::make_shared<math::geometry::CatmullRomSpline>(route);
+    data_.insert(lanelet_id, length);
   }
 
 private:
-  std::unordered_map<lanelet::Id, std::vector<geometry_msgs::msg::Point>> data_;
+  LruCache<lanelet::Id, double> data_;
+};
+
+/**
+ * @brief How moving from one lanelet to the next one on a route is done.
+ */
+struct LaneletTransition
+{
+  /// @note False if the next lanelet is one of the following lanelets of the current one.
+  bool is_lane_change = false;
 
-  std::unordered_map<lanelet::Id, std::shared_ptr<math::geometry::CatmullRomSpline>> splines_;
+  struct Displacement
+  {
+    double s;
+
+    double offset;
+  };
 
-  std::mutex mutex_;
+  /**
+   * @note Position of the origin of the next lanelet in the current lanelet's coordinate. Only for
+   *       lane changes, std::nullopt if the position cannot be determined.
+   */
+  std::optional<Displacement> displacement = std::nullopt;
 };
 
-class LaneletLengthCache
+class LaneletTransitionCache
 {
 public:
-  auto exists(lanelet::Id lanelet_id)
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_.find(lanelet_id) != data_.end();
-  }
+  explicit LaneletTransitionCache(const std::size_t capacity = 0) : data_(capacity) {}
 
-  auto getLength(lanelet::Id lanelet_id)
+  auto getTransition(const lanelet::Id from, const lanelet::Id to)
+    -> std::optional<LaneletTransition>
   {
-    if (!exists(lanelet_id)) {
-      THROW_SIMULATION_ERROR("length of : ", lanelet_id, " does not exists on route cache.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    return data_[lanelet_id];
+    return data_.find({from, to});
   }
 
-  auto appendData(lanelet::Id lanelet_id, double length)
+  auto appendData(
+    const lanelet::Id from, const lanelet::Id to, const LaneletTransition & transition) -> void
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    data_[lanelet_id] = length;
+    data_.insert({from, to}, transition);
   }
 
 private:
-  std::unordered_map<lanelet::Id, double> data_;
+  struct Hash
+  {
+    auto operator()(const std::pair<lanelet::Id, lanelet::Id> & data) const -> std::size_t
+    {
+      std::hash<lanelet::Id> lanelet_id_hash;
+      std::size_t seed = 0;
+      // hash combine like boost library
+      seed ^= lanelet_id_hash(data.first) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      seed ^= lanelet_id_hash(data.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
 
-  std::mutex mutex_;
+  LruCache<std::pair<lanelet::Id, lanelet::Id>, LaneletTransition, Hash> data_;
 };
 }  // namespace hdmap_utils
 
@@ -46,6 +46,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
 #include <traffic_simulator/hdmap_utils/cache.hpp>
+#include <traffic_simulator/hdmap_utils/lanelet_spatial_index.hpp>
+#include <traffic_simulator/hdmap_utils/prebuilt_map.hpp>
+#include <traffic_simulator/hdmap_utils/route_cache_capacity.hpp>
+#include <traffic_simulator/utils/worker_pool.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
 #include <tuple>
@@ -61,7 +65,24 @@ enum class LaneletType { LANE, CROSSWALK };
 class HdMapUtils
 {
 public:
-  explicit HdMapUtils(const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &);
+  /// @param route_cache_capacity Maximum number of routes to cache. 0 means the cache never evicts.
+  explicit HdMapUtils(
+    const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &,
+    const std::size_t route_cache_capacity = default_route_cache_capacity);
+
+  /**
+   * @brief Load the prebuilt map another process has already built from the same lanelet map.
+   * @param prebuilt_map_path Path returned by getPrebuiltMapPath of the other process. It is loaded
+   *        only if it was built with the key of the lanelet map, otherwise the lanelet map is
+   *        loaded in the same way as the other constructor.
+   */
+  explicit HdMapUtils(
+    const boost::filesystem::path &, const boost::filesystem::path & prebuilt_map_path,
+    const geographic_msgs::msg::GeoPoint &,
+    const std::size_t route_cache_capacity = default_route_cache_capacity);
+
+  /// @note Key of the prebuilt map and the shared map image HdMapUtils uses for the lanelet map.
+  static auto prebuiltMapKey(const boost::filesystem::path & lanelet2_map_path) -> PrebuiltMapKey;
 
   auto canChangeLane(const lanelet::Id from, const lanelet::Id to) const -> bool;
 
@@ -181,6 +202,10 @@ public:
     const lanelet::Id, const traffic_simulator_msgs::msg::EntityType &,
     const bool include_opposite_direction = true) const -> lanelet::Ids;
 
+  /// @note Points of all line strings in the map whose type is one of the given types.
+  auto getLineStrings(const std::vector<std::string> & types) const
+    -> std::vector<std::vector<geometry_msgs::msg::Point>>;
+
   auto getLongitudinalDistance(
     const traffic_simulator_msgs::msg::LaneletPose & from,
     const traffic_simulator_msgs::msg::LaneletPose & to, bool allow_lane_change = false) const
@@ -204,6 +229,8 @@ public:
   auto getNextLaneletIds(const lanelet::Id, const std::string & turn_direction) const
     -> lanelet::Ids;
 
+  auto getPrebuiltMapPath() const -> const boost::filesystem::path &;
+
   auto getPreviousLaneletIds(const lanelet::Ids &) const -> lanelet::Ids;
 
   auto getPreviousLaneletIds(const lanelet::Ids &, const std::string & turn_direction) const
@@ -293,6 +320,44 @@ public:
     const geometry_msgs::msg::Pose &, const lanelet::Id, const double matching_distance = 1.0) const
     -> std::optional<traffic_simulator_msgs::msg::LaneletPose>;
 
+  /**
+   * @brief Match the pose in the same way as entities do, to the route lanelets first and then to
+   *        the lanelet the bounding box is on.
+   */
+  auto toLaneletPose(
+    const geometry_msgs::msg::Pose &, const traffic_simulator_msgs::msg::BoundingBox &,
+    const lanelet::Ids & route_lanelets, const bool include_crosswalk,
+    const double matching_distance = 1.0) const
+    -> std::optional<traffic_simulator_msgs::msg::LaneletPose>;
+
+  /**
+   * @brief Match each of the poses to a lanelet in the same way as
+   *        toLaneletPose(pose, include_crosswalk, matching_distance).
+   * @note  Poses close to each other share the lookup of their candidate lanelets, and poses with
+   *        the same candidate lanelet share the lookup of its spline.
+   * @param worker_pool Pool to match the poses on. nullptr matches on the calling thread.
+   * @return Lanelet poses in the same order as the poses.
+   */
+  auto toLaneletPoses(
+    const std::vector<geometry_msgs::msg::Pose> &, const bool include_crosswalk,
+    const double matching_distance = 1.0,
+    traffic_simulator::WorkerPool * worker_pool = nullptr) const
+    -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>;
+
+  /**
+   * @brief Match each of the poses in the same way as
+   *        toLaneletPose(pose, bounding_box, route_lanelets, include_crosswalk, matching_distance).
+   * @param worker_pool Pool to match the poses on. nullptr matches on the calling thread.
+   * @return Lanelet poses in the same order as the poses.
+   */
+  auto toLaneletPoses(
+    const std::vector<geometry_msgs::msg::Pose> &,
+    const std::vector<traffic_simulator_msgs::msg::BoundingBox> &,
+    const std::vector<lanelet::Ids> & route_lanelets, const bool include_crosswalk,
+    const double matching_distance = 1.0,
+    traffic_simulator::WorkerPool * worker_pool = nullptr) const
+    -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>;
+
   auto toLaneletPoses(
     const geometry_msgs::msg::Pose &, const lanelet::Id, const double matching_distance = 5.0,
     const bool include_opposite_direction = true) const
@@ -307,6 +372,9 @@ public:
     const -> geometry_msgs::msg::PoseStamped;
 
 private:
+  /// @note Resolution of the centerlines generated by overwriteLaneletsCenterline, in meters.
+  static constexpr double fine_centerline_resolution = 2.0;
+
   /** @defgroup cache
    *  Declared mutable for caching
    */
@@ -314,14 +382,28 @@ private:
   mutable RouteCache route_cache_;
   mutable CenterPointsCache center_points_cache_;
   mutable LaneletLengthCache lanelet_length_cache_;
+  mutable LaneletTransitionCache lanelet_transition_cache_;
   // @}
 
+  boost::filesystem::path prebuilt_map_path_;
+
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_vehicle_ptr_;
   lanelet::routing::RoutingGraphConstPtr pedestrian_routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_pedestrian_ptr_;
   lanelet::ConstLanelets shoulder_lanelets_;
+  LaneletSpatialIndex lanelet_spatial_index_;
+
+  /** @defgroup index
+   *  Calculated once on construction, since they depend only on the map.
+   */
+  // @{
+  std::unordered_map<lanelet::Id, lanelet::Ids> conflicting_lane_ids_;
+  std::unordered_map<lanelet::Id, lanelet::Ids> conflicting_crosswalk_ids_;
+  /// @note Traffic light way id to the ids of the traffic light regulatory elements referring it.
+  std::unordered_map<lanelet::Id, lanelet::Ids> traffic_light_regulatory_element_ids_;
+  // @}
 
   template <typename Lanelet>
   auto getLaneletIds(const std::vector<Lanelet> & lanelets) const -> lanelet::Ids
@@ -343,14 +425,30 @@ private:
 
   auto calculateAccumulatedLengths(const lanelet::ConstLineString3d &) const -> std::vector<double>;
 
+  auto calculateCenterPoints(const lanelet::ConstLanelet &) const
+    -> std::vector<geometry_msgs::msg::Point>;
+
+  auto calculateConflictingLaneletIds() -> void;
+
   auto calculateSegmentDistances(const lanelet::ConstLineString3d &) const -> std::vector<double>;
 
+  auto calculateTrafficLightRegulatoryElementIds() -> void;
+
   auto excludeSubtypeLanelets(
     const std::vector<std::pair<double, lanelet::Lanelet>> &, const char subtype[]) const
     -> std::vector<std::pair<double, lanelet::Lanelet>>;
 
   auto filterLanelets(const lanelet::Lanelets &, const char subtype[]) const -> lanelet::Lanelets;
 
+  auto findNearbyLanelets(
+    const geometry_msgs::msg::Point &, const double distance_threshold,
+    const std::size_t search_count) const -> std::vector<std::pair<double, lanelet::Lanelet>>;
+
+  auto findNearbyLanelets(
+    const geometry_msgs::msg::Point &, const double distance_threshold,
+    const std::size_t search_count, const LaneletSpatialIndex &) const
+    -> std::vector<std::pair<double, lanelet::Lanelet>>;
+
   auto findNearestIndexPair(
     const std::vector<double> & accumulated_lengths, const double target_length) const
     -> std::pair<std::size_t, std::size_t>;
@@ -363,6 +461,17 @@ private:
     const traffic_simulator::lane_change::TrajectoryShape,
     const double tangent_vector_size = 100) const -> math::geometry::HermiteCurve;
 
+  auto getLaneletTransition(const lanelet::Id from, const lanelet::Id to) const
+    -> LaneletTransition;
+
+  auto getMatchingCandidateLaneletIds(
+    const geometry_msgs::msg::Pose &, const bool include_crosswalk,
+    const double matching_distance) const -> lanelet::Ids;
+
+  auto getMatchingCandidateLaneletIds(
+    const geometry_msgs::msg::Pose &, const bool include_crosswalk,
+    const double matching_distance, const LaneletSpatialIndex &) const -> lanelet::Ids;
+
   auto getNextRoadShoulderLanelet(const lanelet::Id) const -> lanelet::Ids;
 
   auto getPreviousRoadShoulderLanelet(const lanelet::Id) const -> lanelet::Ids;
@@ -393,6 +502,11 @@ private:
   auto resamplePoints(const lanelet::ConstLineString3d &, const std::int32_t num_segments) const
     -> lanelet::BasicPoints3d;
 
+  auto toLaneletPose(
+    const geometry_msgs::msg::Pose &, const lanelet::Id, const math::geometry::CatmullRomSpline &,
+    const double matching_distance) const
+    -> std::optional<traffic_simulator_msgs::msg::LaneletPose>;
+
   auto toPoint2d(const geometry_msgs::msg::Point &) const -> lanelet::BasicPoint2d;
 
   auto toPolygon(const lanelet::ConstLineString3d &) const
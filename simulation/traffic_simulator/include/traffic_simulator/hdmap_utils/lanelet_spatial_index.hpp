@@ -0,0 +1,103 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_SPATIAL_INDEX_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_SPATIAL_INDEX_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <cstddef>
+#include <functional>
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief R-tree over the curves of every lanelet's center points spline and over the lanelet areas.
+ * @note  Curves are indexed by the bounding boxes math::geometry::CatmullRomSpline computes for
+ *        them, and curve indices match the curves of that spline.
+ */
+class LaneletSpatialIndex
+{
+public:
+  using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+
+  using Box = boost::geometry::model::box<Point>;
+
+  using Segment = boost::geometry::model::segment<Point>;
+
+  struct Curve
+  {
+    lanelet::Id lanelet_id;
+
+    std::size_t index;
+
+    /// @note Line segment between the control points at both ends of the curve.
+    Segment chord;
+  };
+
+  using CenterPointsSplineFunction =
+    std::function<std::shared_ptr<math::geometry::CatmullRomSpline>(const lanelet::ConstLanelet &)>;
+
+  LaneletSpatialIndex() = default;
+
+  explicit LaneletSpatialIndex(const lanelet::LaneletLayer &, const CenterPointsSplineFunction &);
+
+  /**
+   * @brief Get curves which may come within the distance of the point.
+   * @return Pairs of the distance from the point to the chord of the curve and the curve, sorted by
+   *         the distance, and then by the lanelet id and the curve index.
+   */
+  auto getCurves(const geometry_msgs::msg::Point &, const double distance) const
+    -> std::vector<std::pair<double, Curve>>;
+
+  /**
+   * @brief Get lanelets whose bounding box is within the distance of the point.
+   * @note  This is a broad phase, callers need to check the exact distance to the lanelet area.
+   * @return Lanelet ids sorted in ascending order.
+   */
+  auto getLaneletIds(const geometry_msgs::msg::Point &, const double distance) const
+    -> lanelet::Ids;
+
+  /**
+   * @brief Get the index of the curves and lanelets which may come within the distance of any of
+   *        the points.
+   * @note  Queries of these points within the distance give the same results on the subset as on
+   *        this index, so points close to each other can share one traversal of this index.
+   */
+  auto getSubset(const std::vector<geometry_msgs::msg::Point> &, const double distance) const
+    -> LaneletSpatialIndex;
+
+private:
+  using CurveValue = std::pair<Box, Curve>;
+
+  using LaneletValue = std::pair<Box, lanelet::Id>;
+
+  explicit LaneletSpatialIndex(std::vector<CurveValue> &&, std::vector<LaneletValue> &&);
+
+  static auto makeQueryBox(const geometry_msgs::msg::Point &, const double distance) -> Box;
+
+  boost::geometry::index::rtree<CurveValue, boost::geometry::index::rstar<16>> curves_;
+
+  boost::geometry::index::rtree<LaneletValue, boost::geometry::index::rstar<16>> lanelets_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__LANELET_SPATIAL_INDEX_HPP_
@@ -0,0 +1,80 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__PREBUILT_MAP_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__PREBUILT_MAP_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <string>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Identifies a lanelet map that has already been parsed, projected and had its centerlines
+ *        overwritten, so that the result can be stored on disk and reused by later processes.
+ * @note  Any change to the map file contents, the projector or the centerline resolution yields a
+ *        different key, and a cache file written with a different key is never loaded.
+ */
+struct PrebuiltMapKey
+{
+  /// @note Increment this whenever the layout of the cache file or the preprocessing changes.
+  static constexpr std::uint32_t format_version = 1;
+
+  explicit PrebuiltMapKey(
+    const boost::filesystem::path & lanelet2_map_path, const std::string & projector,
+    const double centerline_resolution);
+
+  auto cachePath() const -> boost::filesystem::path;
+
+  auto operator==(const PrebuiltMapKey &) const -> bool;
+
+  const boost::filesystem::path lanelet2_map_path;
+
+  const std::uint64_t lanelet2_map_hash;
+
+  const std::string projector;
+
+  const double centerline_resolution;
+};
+
+/**
+ * @brief Load the prebuilt lanelet map identified by the key.
+ * @return Loaded map, or nullptr if there is no cache file, the cache file was written with a
+ *         different key, or the cache file is broken. Callers are expected to fall back to loading
+ *         the original map file in that case.
+ */
+auto loadPrebuiltMap(const PrebuiltMapKey &) -> lanelet::LaneletMapPtr;
+
+/**
+ * @brief Load the prebuilt lanelet map stored at the path by another process.
+ * @note  The path need not be the cache path of the key, but the map is loaded only if it was
+ *        written with the same key, so a stale or foreign file is never attached to.
+ * @return Loaded map, or nullptr if there is no cache file, the cache file was written with a
+ *         different key, or the cache file is broken.
+ */
+auto loadPrebuiltMap(const PrebuiltMapKey &, const boost::filesystem::path & cache_path)
+  -> lanelet::LaneletMapPtr;
+
+/**
+ * @brief Store the prebuilt lanelet map under the key.
+ * @note  Failing to write the cache is not an error; it is logged and the next process simply
+ *        rebuilds the map.
+ */
+auto savePrebuiltMap(const PrebuiltMapKey &, const lanelet::LaneletMap &) -> void;
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__PREBUILT_MAP_HPP_
@@ -0,0 +1,26 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_CACHE_CAPACITY_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_CACHE_CAPACITY_HPP_
+
+#include <cstddef>
+
+namespace hdmap_utils
+{
+/// @note Routes between random lanelets are unbounded, so the route cache is bounded by default.
+constexpr std::size_t default_route_cache_capacity = 1 << 14;
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__ROUTE_CACHE_CAPACITY_HPP_
@@ -0,0 +1,81 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__SHARED_MAP_IMAGE_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__SHARED_MAP_IMAGE_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/managed_mapped_file.hpp>
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <memory>
+#include <string>
+#include <traffic_simulator/hdmap_utils/prebuilt_map.hpp>
+#include <utility>
+#include <vector>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Read-only geometry of a prebuilt lanelet map, used in place from a file mapping.
+ * @note  The prebuilt map is deserialized into the heap of every process loading it. The image
+ *        instead holds plain arrays addressed by offsets, so every process mapping it reads the
+ *        same physical pages. It holds only what the sensor simulator needs to build its static
+ *        environment (the bounds of lanelets and the line strings by type), not Lanelet2
+ *        primitives, routing graphs or indices.
+ */
+class SharedMapImage
+{
+public:
+  /// @note Increment this whenever the layout of the image changes.
+  static constexpr std::uint32_t format_version = 1;
+
+  /// @note The image is stored next to the prebuilt map it is made from.
+  static auto imagePath(const boost::filesystem::path & prebuilt_map_path)
+    -> boost::filesystem::path;
+
+  /**
+   * @brief Map the image stored at the path read-only.
+   * @return Image, or nullptr if there is no image, the image was written with a different key, or
+   *         the image is broken. Callers are expected to fall back to HdMapUtils in that case.
+   */
+  static auto open(const PrebuiltMapKey &, const boost::filesystem::path & image_path)
+    -> std::shared_ptr<const SharedMapImage>;
+
+  /**
+   * @brief Store the image of the lanelet map under the key.
+   * @note  Failing to write the image is not an error; it is logged in the same way as
+   *        savePrebuiltMap and readers fall back to HdMapUtils.
+   */
+  static auto save(const PrebuiltMapKey &, const lanelet::LaneletMap &) -> void;
+
+  /// @note Left and right bounds of every lanelet, in the same form as HdMapUtils::getLeftBound.
+  auto getLaneletBounds() const -> std::vector<
+    std::pair<std::vector<geometry_msgs::msg::Point>, std::vector<geometry_msgs::msg::Point>>>;
+
+  /// @note Same as HdMapUtils::getLineStrings for a single type.
+  auto getLineStrings(const std::string & type) const
+    -> std::vector<std::vector<geometry_msgs::msg::Point>>;
+
+private:
+  explicit SharedMapImage(const boost::filesystem::path & image_path);
+
+  /// @note Mutable because the lookup of named objects is not const, though it never writes.
+  mutable boost::interprocess::managed_mapped_file file_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__SHARED_MAP_IMAGE_HPP_
@@ -119,6 +119,11 @@ const simulation_api_schema::LidarConfiguration constructLidarConfiguration(
   const LidarType type, const std::string & entity, const std::string & architecture_type,
   const double lidar_sensor_delay = 0, const double horizontal_resolution = 1.0 / 180.0 * M_PI);
 
+/// @note If static_environment is true, rays also hit the road surface, curbs and walls of the map.
+const simulation_api_schema::LidarConfiguration constructLidarConfiguration(
+  const LidarType type, const std::string & entity, const std::string & architecture_type,
+  const double lidar_sensor_delay, const bool static_environment);
+
 const simulation_api_schema::DetectionSensorConfiguration constructDetectionSensorConfiguration(
   const std::string & entity, const std::string & architecture_type, const double update_duration,
   const double range = 300.0, const bool detect_all_objects_in_range = false,
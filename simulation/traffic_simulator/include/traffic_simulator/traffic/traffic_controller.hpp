@@ -43,7 +43,8 @@ class TrafficController
 public:
   explicit TrafficController(
     std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils,
-    const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+    const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+      get_entity_names_in_range_function,
     const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
     const std::function<void(std::string)> & despawn_function, bool auto_sink = false);
   template <typename T, typename... Ts>
@@ -58,7 +59,8 @@ private:
   void autoSink();
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
   std::vector<std::shared_ptr<traffic_simulator::traffic::TrafficModuleBase>> modules_;
-  const std::function<std::vector<std::string>(void)> get_entity_names_function;
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)>
+    get_entity_names_in_range_function;
   const std::function<geometry_msgs::msg::Pose(const std::string &)> get_entity_pose_function;
   const std::function<void(const std::string &)> despawn_function;
 
@@ -41,7 +41,8 @@ class TrafficSink : public TrafficModuleBase
 public:
   explicit TrafficSink(
     double radius, const geometry_msgs::msg::Point & position,
-    const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+    const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+      get_entity_names_in_range_function,
     const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
     const std::function<void(std::string)> & despawn_function);
   const double radius;
@@ -49,7 +50,9 @@ public:
   void execute(const double current_time, const double step_time) override;
 
 private:
-  const std::function<std::vector<std::string>(void)> get_entity_names_function;
+  /// @note Returns candidates of entities in range, whose poses are checked by the sink.
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)>
+    get_entity_names_in_range_function;
   const std::function<geometry_msgs::msg::Pose(const std::string &)> get_entity_pose_function;
   const std::function<void(const std::string &)> despawn_function;
 };
@@ -16,6 +16,7 @@
 #define TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_HPP_
 
 #include <color_names/color_names.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <geometry_msgs/msg/point.hpp>
 #include <iostream>
@@ -248,6 +249,11 @@ struct TrafficLight
       return lhs.hash() < rhs.hash();
     }
 
+    friend constexpr auto operator==(const Bulb & lhs, const Bulb & rhs) -> bool
+    {
+      return lhs.hash() == rhs.hash();
+    }
+
     friend auto operator<<(std::ostream & os, const Bulb & bulb) -> std::ostream &;
 
     explicit operator simulation_api_schema::TrafficLight() const
@@ -320,19 +326,29 @@ struct TrafficLight
     }
   };
 
-  const lanelet::Id way_id;
+private:
+  double confidence_ = 1.0;
 
-  double confidence = 1.0;
+  std::set<Bulb> bulbs_;
 
-  std::set<Bulb> bulbs;
+  std::size_t version_ = 0;
+
+public:
+  const lanelet::Id way_id;
 
   const std::map<Bulb::Hash, std::optional<geometry_msgs::msg::Point>> positions;
 
   explicit TrafficLight(const lanelet::Id, hdmap_utils::HdMapUtils &);
 
-  auto clear() { bulbs.clear(); }
+  auto clear() -> void
+  {
+    if (not bulbs_.empty()) {
+      bulbs_.clear();
+      ++version_;
+    }
+  }
 
-  auto contains(const Bulb & bulb) const { return bulbs.find(bulb) != std::end(bulbs); }
+  auto contains(const Bulb & bulb) const { return bulbs_.find(bulb) != std::end(bulbs_); }
 
   auto contains(const Color & color, const Status & status, const Shape & shape) const
   {
@@ -352,7 +368,7 @@ struct TrafficLight
       }
     };
 
-    for (const auto & bulb : bulbs) {
+    for (const auto & bulb : bulbs_) {
       if (optional_position(bulb).has_value() and bulb.is(Shape::Category::circle)) {
         visualization_msgs::msg::Marker marker;
         marker.header.stamp = now;
@@ -374,15 +390,36 @@ struct TrafficLight
   }
 
   template <typename... Ts>
-  auto emplace(Ts &&... xs)
+  auto emplace(Ts &&... xs) -> void
   {
-    bulbs.emplace(std::forward<decltype(xs)>(xs)...);
+    if (bulbs_.emplace(std::forward<decltype(xs)>(xs)...).second) {
+      ++version_;
+    }
   }
 
-  auto empty() const { return bulbs.empty(); }
+  auto empty() const { return bulbs_.empty(); }
 
   auto set(const std::string & states) -> void;
 
+  /**
+   * @brief Replace the bulbs with the given states.
+   * @note  Unlike clear followed by set, the version is incremented only if the bulbs change.
+   */
+  auto assign(const std::string & states) -> void;
+
+  auto getConfidence() const noexcept { return confidence_; }
+
+  auto setConfidence(const double confidence) -> void
+  {
+    if (confidence_ != confidence) {
+      confidence_ = confidence;
+      ++version_;
+    }
+  }
+
+  /// @note Incremented whenever the bulbs or the confidence change, never decremented.
+  auto version() const noexcept { return version_; }
+
   friend auto operator<<(std::ostream & os, const TrafficLight & traffic_light) -> std::ostream &;
 
   explicit operator simulation_api_schema::TrafficSignal() const
@@ -390,9 +427,9 @@ struct TrafficLight
     simulation_api_schema::TrafficSignal traffic_signal_proto;
 
     traffic_signal_proto.set_id(way_id);
-    for (const auto & bulb : bulbs) {
+    for (const auto & bulb : bulbs_) {
       auto traffic_light_bulb_proto = static_cast<simulation_api_schema::TrafficLight>(bulb);
-      traffic_light_bulb_proto.set_confidence(confidence);
+      traffic_light_bulb_proto.set_confidence(confidence_);
       *traffic_signal_proto.add_traffic_light_status() = traffic_light_bulb_proto;
     }
     return traffic_signal_proto;
@@ -15,8 +15,10 @@
 #ifndef TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
 #define TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
 
+#include <cstddef>
 #include <iomanip>
 #include <memory>
+#include <mutex>
 #include <rclcpp/rclcpp.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <stdexcept>  // std::out_of_range
@@ -37,6 +39,9 @@ protected:
 
   TrafficLightMap traffic_lights_;
 
+  /// @note Traffic lights are created on first access, possibly by entities updated in parallel.
+  mutable std::mutex traffic_lights_mutex_;
+
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_;
 
 public:
@@ -53,7 +58,15 @@ public:
   auto getTrafficLights(const lanelet::Id lanelet_id)
     -> std::vector<std::reference_wrapper<TrafficLight>>;
 
-  auto hasAnyLightChanged() -> bool;
+  /**
+   * @brief Version of all traffic lights, which increases whenever any of them changes or a new one
+   *        is created.
+   * @note  Consumers keep the version they have processed last and compare it with this one, so
+   *        that each of them sees every change regardless of the others.
+   */
+  auto getVersion() const -> std::size_t;
+
+  auto hasAnyLightChanged(const std::size_t since_version) const -> bool;
 
   auto generateUpdateTrafficLightsRequest() -> simulation_api_schema::UpdateTrafficLightsRequest;
 };
@@ -0,0 +1,97 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__UTILS__ENTITY_BROADPHASE_HPP_
+#define TRAFFIC_SIMULATOR__UTILS__ENTITY_BROADPHASE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <string>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator_msgs/msg/bounding_box.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Axis aligned bounding box of an entity on the xy plane.
+ * @note  It also contains the position of the entity, which may be outside of its bounding box.
+ */
+struct BoundingBox2D
+{
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+
+  explicit BoundingBox2D(
+    const geometry_msgs::msg::Pose &, const traffic_simulator_msgs::msg::BoundingBox &);
+
+  explicit BoundingBox2D(const geometry_msgs::msg::Point & center, double radius);
+
+  auto intersects(const BoundingBox2D &) const noexcept -> bool;
+};
+
+/**
+ * @brief Broadphase over the statuses of all entities: a uniform grid of their bounding boxes and
+ *        an index of them by lanelet.
+ * @note  Queries may return entities which are not actually in range, so callers have to run their
+ *        own exact check on the results. Results are in the iteration order of the statuses, the
+ *        same order as looping over all statuses and filtering them.
+ */
+class EntityBroadphase
+{
+public:
+  using Statuses = std::unordered_map<std::string, CanonicalizedEntityStatus>;
+
+  explicit EntityBroadphase(const Statuses &, double cell_size = 10.0);
+
+  auto getEntityNamesInRange(const geometry_msgs::msg::Point & center, double radius) const
+    -> std::vector<std::string>;
+
+  /// @note Entities which failed to match to any lanelet are never returned.
+  auto getEntityNamesOnLanelets(const lanelet::Ids &) const -> std::vector<std::string>;
+
+private:
+  auto getCellIndex(double) const -> std::int32_t;
+
+  static auto getCellKey(std::int32_t x, std::int32_t y) -> std::uint64_t;
+
+  template <typename Function>
+  auto forEachCell(const BoundingBox2D & bounding_box, Function && function) const -> void
+  {
+    for (auto x = getCellIndex(bounding_box.min_x); x <= getCellIndex(bounding_box.max_x); ++x) {
+      for (auto y = getCellIndex(bounding_box.min_y); y <= getCellIndex(bounding_box.max_y); ++y) {
+        function(getCellKey(x, y));
+      }
+    }
+  }
+
+  const double cell_size_;
+
+  std::vector<std::string> names_;
+
+  std::vector<BoundingBox2D> bounding_boxes_;
+
+  /// @note Indices of names_ whose bounding box overlaps each cell.
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells_;
+
+  std::unordered_map<lanelet::Id, std::vector<std::size_t>> lanelets_;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__UTILS__ENTITY_BROADPHASE_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__UTILS__WORKER_POOL_HPP_
+#define TRAFFIC_SIMULATOR__UTILS__WORKER_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace traffic_simulator
+{
+/**
+ * @brief Fixed set of threads running a job for every index of a range.
+ * @note  Threads are started once on construction and wait for jobs, instead of being started for
+ *        every job. The calling thread also takes part in running a job.
+ */
+class WorkerPool
+{
+public:
+  /// @note thread_count includes the calling thread, so thread_count - 1 threads are started.
+  explicit WorkerPool(const std::size_t thread_count);
+
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Call the function for each index from 0 to size - 1, and wait for all of them.
+   * @note  If some calls throw, the exception of the smallest index is rethrown after all calls
+   *        finished, so which exception is rethrown does not depend on thread scheduling.
+   */
+  auto run(const std::size_t size, const std::function<void(std::size_t)> & function) -> void;
+
+  auto threadCount() const noexcept -> std::size_t { return threads_.size() + 1; }
+
+private:
+  auto runJob() -> void;
+
+  auto work() -> void;
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+
+  std::condition_variable job_started_;
+
+  std::condition_variable job_finished_;
+
+  /// @note Incremented for every job, so that threads can tell a new job from the previous one.
+  std::size_t job_count_ = 0;
+
+  std::size_t busy_thread_count_ = 0;
+
+  bool stopped_ = false;
+
+  const std::function<void(std::size_t)> * function_ = nullptr;
+
+  std::size_t size_ = 0;
+
+  std::atomic<std::size_t> next_index_{0};
+
+  std::vector<std::exception_ptr> exceptions_;
+};
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__UTILS__WORKER_POOL_HPP_
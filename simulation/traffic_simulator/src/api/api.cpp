@@ -24,6 +24,8 @@
 #include <traffic_simulator/api/api.hpp>
 #include <traffic_simulator/traffic/traffic_source.hpp>
 #include <traffic_simulator/utils/pose.hpp>
+#include <utility>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -247,63 +249,106 @@ bool API::attachLidarSensor(const simulation_api_schema::LidarConfiguration & li
 
 bool API::attachLidarSensor(
   const std::string & entity_name, const double lidar_sensor_delay,
-  const helper::LidarType lidar_type)
+  const helper::LidarType lidar_type, const bool static_environment)
 {
   return attachLidarSensor(helper::constructLidarConfiguration(
     lidar_type, entity_name, getParameter<std::string>("architecture_type", "awf/universe"),
-    lidar_sensor_delay));
+    lidar_sensor_delay, static_environment));
 }
 
-bool API::updateTimeInSim()
+auto API::makeUpdateFrameRequest() -> simulation_api_schema::UpdateFrameRequest
 {
   simulation_api_schema::UpdateFrameRequest request;
   request.set_current_simulation_time(clock_.getCurrentSimulationTime());
   request.set_current_scenario_time(getCurrentTime());
   simulation_interface::toProto(
     clock_.getCurrentRosTimeAsMsg().clock, *request.mutable_current_ros_time());
-  return zeromq_client_.call(request).result().success();
+  return request;
 }
 
-bool API::updateTrafficLightsInSim()
+auto API::makeUpdateEntityStatusRequest() -> simulation_api_schema::UpdateEntityStatusRequest
 {
-  if (entity_manager_ptr_->trafficLightsChanged()) {
-    auto req = entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights();
-    return zeromq_client_.call(req).result().success();
+  simulation_api_schema::UpdateEntityStatusRequest req;
+  req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
+  auto entity_statuses = entity_manager_ptr_->getEntityStatuses();
+  if (configuration.delta_encoded_entity_status) {
+    /// @note Ego is always sent with all fields, since the simulator overwrites its status.
+    for (const auto & status : entity_statuses) {
+      const auto is_ego = entity_manager_ptr_->is<entity::EgoEntity>(status.name);
+      if (simulation_api_schema::EntityStatusDelta delta; entity_status_delta_encoder_.encode(
+            entity_manager_ptr_->getEntityId(status.name), status, is_ego, delta)) {
+        *req.add_status_delta() = std::move(delta);
+      }
+      if (is_ego) {
+        req.set_overwrite_ego_status(entity_manager_ptr_->isControlledBySimulator(status.name));
+      }
+    }
+  } else {
+    req.mutable_status()->Reserve(entity_statuses.size());
+    for (const auto & status : entity_statuses) {
+      simulation_interface::toProto(status, *req.add_status());
+      if (entity_manager_ptr_->is<entity::EgoEntity>(status.name)) {
+        req.set_overwrite_ego_status(entity_manager_ptr_->isControlledBySimulator(status.name));
+      }
+    }
   }
-  /// @todo handle response
-  return simulation_api_schema::UpdateTrafficLightsResponse().result().success();
+  return req;
 }
 
-bool API::updateEntitiesStatusInSim()
+auto API::applyUpdateEntityStatusResponse(
+  const simulation_api_schema::UpdateEntityStatusResponse & res) -> void
 {
-  simulation_api_schema::UpdateEntityStatusRequest req;
-  req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
-  for (const auto & entity_name : entity_manager_ptr_->getEntityNames()) {
-    auto entity_status = entity_manager_ptr_->getEntityStatus(entity_name);
-    simulation_interface::toProto(static_cast<EntityStatus>(entity_status), *req.add_status());
-    if (entity_manager_ptr_->is<entity::EgoEntity>(entity_name)) {
-      req.set_overwrite_ego_status(entity_manager_ptr_->isControlledBySimulator(entity_name));
+  std::vector<EntityStatus> entity_statuses;
+  const auto apply = [&](const std::string & name, const auto & res_status) {
+    auto entity_status = static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(name));
+    simulation_interface::toMsg(res_status.pose(), entity_status.pose);
+    simulation_interface::toMsg(res_status.action_status(), entity_status.action_status);
+
+    if (entity_manager_ptr_->is<entity::EgoEntity>(name)) {
+      setMapPose(name, entity_status.pose);
+      setTwist(name, entity_status.action_status.twist);
+      setAcceleration(name, entity_status.action_status.accel);
+    } else {
+      entity_statuses.push_back(entity_status);
     }
+  };
+
+  for (const auto & res_status : res.status()) {
+    apply(res_status.name(), res_status);
   }
 
-  simulation_api_schema::UpdateEntityStatusResponse res;
-  if (auto res = zeromq_client_.call(req); res.result().success()) {
-    for (const auto & res_status : res.status()) {
-      auto name = res_status.name();
-      auto entity_status = static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(name));
-      simulation_interface::toMsg(res_status.pose(), entity_status.pose);
-      simulation_interface::toMsg(res_status.action_status(), entity_status.action_status);
-
-      if (entity_manager_ptr_->is<entity::EgoEntity>(name)) {
-        setMapPose(name, entity_status.pose);
-        setTwist(name, entity_status.action_status.twist);
-        setAcceleration(name, entity_status.action_status.accel);
-      } else {
-        setEntityStatus(name, canonicalize(entity_status));
-      }
+  for (const auto & res_status : res.status_delta()) {
+    apply(entity_status_delta_encoder_.name(res_status.id()), res_status);
+  }
+
+  entity_manager_ptr_->setEntityStatuses(entity_statuses);
+}
+
+/**
+ * @note Entity status, traffic lights and time of the frame are sent in one FrameStepRequest, so
+ * that a frame costs a single round trip to the simulator instead of three. All of them are taken
+ * at the beginning of the frame, before the entities are updated: the simulator renders sensors of
+ * the entity status and traffic lights at the time of the frame. Traffic lights are not changed by
+ * updating entities, so they are the same as those which used to be sent after the update.
+ */
+bool API::updateFrameInSim()
+{
+  simulation_api_schema::FrameStepRequest request;
+  *request.mutable_update_entity_status() = makeUpdateEntityStatusRequest();
+  if (not configuration.standalone_mode) {
+    if (entity_manager_ptr_->trafficLightsChanged()) {
+      *request.mutable_update_traffic_lights() =
+        entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights();
     }
+    *request.mutable_update_frame() = makeUpdateFrameRequest();
+  }
+  if (const auto response = zeromq_client_.call(request); response.result().success()) {
+    entity_status_delta_encoder_.flush();
+    applyUpdateEntityStatusResponse(response.update_entity_status());
     return true;
   }
+  /// @note The simulator may not have the statuses of the frame, so the next frame sends them all.
+  entity_status_delta_encoder_.reset();
   return false;
 }
 
@@ -313,19 +358,13 @@ bool API::updateFrame()
     THROW_SEMANTIC_ERROR("Ego simulation is no longer supported in standalone mode");
   }
 
-  if (!updateEntitiesStatusInSim()) {
+  if (!updateFrameInSim()) {
     return false;
   }
 
   entity_manager_ptr_->update(getCurrentTime(), clock_.getStepTime());
   traffic_controller_ptr_->execute(getCurrentTime(), clock_.getStepTime());
 
-  if (not configuration.standalone_mode) {
-    if (!updateTrafficLightsInSim() || !updateTimeInSim()) {
-      return false;
-    }
-  }
-
   entity_manager_ptr_->broadcastEntityTransform();
   clock_.update();
   clock_pub_->publish(clock_.getCurrentRosTimeAsMsg());
@@ -0,0 +1,35 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <mutex>
+#include <traffic_simulator/behavior/behavior_plugin_loader.hpp>
+
+namespace entity_behavior
+{
+auto getBehaviorPluginLoader() -> std::shared_ptr<BehaviorPluginLoader>
+{
+  static std::mutex mutex;
+  static std::weak_ptr<BehaviorPluginLoader> shared_loader;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (auto loader = shared_loader.lock()) {
+    return loader;
+  } else {
+    loader = std::make_shared<BehaviorPluginLoader>(
+      "traffic_simulator", "entity_behavior::BehaviorPluginBase");
+    shared_loader = loader;
+    return loader;
+  }
+}
+}  // namespace entity_behavior
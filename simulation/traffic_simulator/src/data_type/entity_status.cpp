@@ -12,8 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <traffic_simulator/data_type/entity_status.hpp>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
+#include <traffic_simulator/utils/entity_broadphase.hpp>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -123,6 +130,96 @@ auto CanonicalizedEntityStatus::getLinearJerk() const noexcept -> double
 auto CanonicalizedEntityStatus::setTime(double time) -> void { entity_status_.time = time; }
 
 auto CanonicalizedEntityStatus::getTime() const noexcept -> double { return entity_status_.time; }
+
+auto EntityStatusSnapshot::getBroadphase() const -> const EntityBroadphase &
+{
+  std::call_once(broadphase_once_flag_, [this]() {
+    broadphase_ = std::make_shared<const EntityBroadphase>(statuses);
+  });
+  return *broadphase_;
+}
+
+OtherEntityStatus::OtherEntityStatus(
+  const std::shared_ptr<const EntityStatusSnapshot> & snapshot, const std::string & excluded_name)
+: snapshot_(snapshot), excluded_name_(excluded_name)
+{
+  if (const auto iter = statuses().find(excluded_name_); iter != statuses().end()) {
+    excluded_status_ = &*iter;
+  }
+}
+
+auto OtherEntityStatus::at(const std::string & name) const -> const CanonicalizedEntityStatus &
+{
+  if (const auto iter = find(name); iter != end()) {
+    return iter->second;
+  } else {
+    throw std::out_of_range("OtherEntityStatus::at");
+  }
+}
+
+auto OtherEntityStatus::begin() const -> const_iterator
+{
+  return const_iterator(IsOtherEntity{excluded_status_}, statuses().begin(), statuses().end());
+}
+
+auto OtherEntityStatus::count(const std::string & name) const -> std::size_t
+{
+  return find(name) == end() ? 0 : 1;
+}
+
+auto OtherEntityStatus::empty() const -> bool { return size() == 0; }
+
+auto OtherEntityStatus::end() const -> const_iterator
+{
+  return const_iterator(IsOtherEntity{excluded_status_}, statuses().end(), statuses().end());
+}
+
+auto OtherEntityStatus::find(const std::string & name) const -> const_iterator
+{
+  if (name == excluded_name_) {
+    return end();
+  } else {
+    return const_iterator(IsOtherEntity{excluded_status_}, statuses().find(name), statuses().end());
+  }
+}
+
+auto OtherEntityStatus::getEntityNamesInRange(
+  const geometry_msgs::msg::Point & center, const double radius) const -> std::vector<std::string>
+{
+  if (not snapshot_) {
+    return {};
+  }
+  auto names = snapshot_->getBroadphase().getEntityNamesInRange(center, radius);
+  names.erase(std::remove(names.begin(), names.end(), excluded_name_), names.end());
+  return names;
+}
+
+auto OtherEntityStatus::getEntityNamesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<std::string>
+{
+  if (not snapshot_) {
+    return {};
+  }
+  auto names = snapshot_->getBroadphase().getEntityNamesOnLanelets(lanelet_ids);
+  names.erase(std::remove(names.begin(), names.end(), excluded_name_), names.end());
+  return names;
+}
+
+auto OtherEntityStatus::size() const -> std::size_t
+{
+  return statuses().size() - (excluded_status_ ? 1 : 0);
+}
+
+auto OtherEntityStatus::statuses() const -> const Statuses &
+{
+  static const Statuses empty_statuses;
+  return snapshot_ ? snapshot_->statuses : empty_statuses;
+}
+
+auto OtherEntityStatus::version() const -> std::size_t
+{
+  return snapshot_ ? snapshot_->version : 0;
+}
 }  // namespace entity_status
 
 bool isSameLaneletId(const CanonicalizedEntityStatus & s0, const CanonicalizedEntityStatus & s1)
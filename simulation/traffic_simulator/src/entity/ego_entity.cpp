@@ -114,8 +114,11 @@ auto EgoEntity::getEntityTypename() const -> const std::string &
 
 auto EgoEntity::getEntityType() const -> const traffic_simulator_msgs::msg::EntityType &
 {
-  static traffic_simulator_msgs::msg::EntityType type;
-  type.type = traffic_simulator_msgs::msg::EntityType::EGO;
+  static const auto type = []() {
+    traffic_simulator_msgs::msg::EntityType type;
+    type.type = traffic_simulator_msgs::msg::EntityType::EGO;
+    return type;
+  }();
   return type;
 }
 
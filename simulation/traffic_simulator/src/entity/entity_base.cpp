@@ -94,20 +94,10 @@ auto EntityBase::fillLaneletPose(CanonicalizedEntityStatus & status, bool includ
 {
   const auto unique_route_lanelets = traffic_simulator::helper::getUniqueValues(getRouteLanelets());
 
-  std::optional<traffic_simulator_msgs::msg::LaneletPose> lanelet_pose;
   auto status_non_canonicalized = static_cast<EntityStatus>(status);
 
-  if (unique_route_lanelets.empty()) {
-    lanelet_pose = hdmap_utils_ptr_->toLaneletPose(
-      status_non_canonicalized.pose, getBoundingBox(), include_crosswalk, 1.0);
-  } else {
-    lanelet_pose =
-      hdmap_utils_ptr_->toLaneletPose(status_non_canonicalized.pose, unique_route_lanelets, 1.0);
-    if (!lanelet_pose) {
-      lanelet_pose = hdmap_utils_ptr_->toLaneletPose(
-        status_non_canonicalized.pose, getBoundingBox(), include_crosswalk, 1.0);
-    }
-  }
+  const auto lanelet_pose = hdmap_utils_ptr_->toLaneletPose(
+    status_non_canonicalized.pose, getBoundingBox(), unique_route_lanelets, include_crosswalk, 1.0);
   if (lanelet_pose) {
     math::geometry::CatmullRomSpline spline(
       hdmap_utils_ptr_->getCenterPoints(lanelet_pose->lanelet_id));
@@ -562,11 +552,9 @@ void EntityBase::setDynamicConstraints(
   setBehaviorParameter(behavior_parameter);
 }
 
-void EntityBase::setOtherStatus(
-  const std::unordered_map<std::string, CanonicalizedEntityStatus> & status)
+void EntityBase::setOtherStatus(const std::shared_ptr<const EntityStatusSnapshot> & snapshot)
 {
-  other_status_ = status;
-  other_status_.erase(name);
+  other_status_ = OtherEntityStatus(snapshot, name);
 }
 
 auto EntityBase::setStatus(const CanonicalizedEntityStatus & status) -> void
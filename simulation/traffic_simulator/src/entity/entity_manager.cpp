@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <geometry/bounding_box.hpp>
 #include <geometry/distance.hpp>
@@ -30,6 +31,7 @@
 #include <traffic_simulator/helper/helper.hpp>
 #include <traffic_simulator/helper/stop_watch.hpp>
 #include <traffic_simulator/utils/distance.hpp>
+#include <traffic_simulator/utils/entity_broadphase.hpp>
 #include <unordered_map>
 #include <vector>
 
@@ -39,7 +41,6 @@ namespace entity
 {
 void EntityManager::broadcastEntityTransform()
 {
-  std::vector<std::string> names = getEntityNames();
   /**
    * @note This part of the process is intended to ensure that frames are issued in a position that makes 
    * it as easy as possible to see the entities that will appear in the scenario.
@@ -61,17 +62,17 @@ void EntityManager::broadcastEntityTransform()
         true);
     }
   }
-  if (!names.empty()) {
+  if (!entities_.empty()) {
     broadcastTransform(
       geometry_msgs::build<geometry_msgs::msg::PoseStamped>()
         .header(
           std_msgs::build<std_msgs::msg::Header>().stamp(clock_ptr_->now()).frame_id("entities"))
         .pose(geometry_msgs::build<geometry_msgs::msg::Pose>()
                 .position(std::accumulate(
-                  names.begin(), names.end(), geometry_msgs::msg::Point(),
-                  [this, names](geometry_msgs::msg::Point & point, const std::string & name) {
-                    return point +
-                           (getMapPose(name).position * (1.0 / static_cast<double>(names.size())));
+                  entities_.begin(), entities_.end(), geometry_msgs::msg::Point(),
+                  [this](geometry_msgs::msg::Point & point, const auto & entity) {
+                    return point + (entity.second->getMapPose().position *
+                                    (1.0 / static_cast<double>(entities_.size())));
                   }))
                 .orientation(geometry_msgs::msg::Quaternion())),
       true);
@@ -101,9 +102,16 @@ void EntityManager::broadcastTransform(
 
 bool EntityManager::checkCollision(const std::string & name0, const std::string & name1)
 {
-  return name0 != name1 and
-         math::geometry::checkCollision2D(
-           getMapPose(name0), getBoundingBox(name0), getMapPose(name1), getBoundingBox(name1));
+  if (name0 == name1) {
+    return false;
+  }
+  const auto pose0 = getMapPose(name0);
+  const auto pose1 = getMapPose(name1);
+  const auto bounding_box0 = getBoundingBox(name0);
+  const auto bounding_box1 = getBoundingBox(name1);
+  /// @note Polygons are only built for entities whose axis aligned bounding boxes intersect.
+  return BoundingBox2D(pose0, bounding_box0).intersects(BoundingBox2D(pose1, bounding_box1)) and
+         math::geometry::checkCollision2D(pose0, bounding_box0, pose1, bounding_box1);
 }
 
 visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
@@ -117,6 +125,7 @@ visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 
 bool EntityManager::despawnEntity(const std::string & name)
 {
+  entity_ids_.erase(name);
   return entityExists(name) && entities_.erase(name);
 }
 
@@ -136,6 +145,36 @@ auto EntityManager::getEntityNames() const -> const std::vector<std::string>
   return names;
 }
 
+auto EntityManager::getEntityNamesInRange(
+  const geometry_msgs::msg::Point & center, const double radius) const -> std::vector<std::string>
+{
+  std::vector<std::string> names;
+  if (entity_status_snapshot_) {
+    const auto & broadphase = entity_status_snapshot_->getBroadphase();
+    for (auto && name : broadphase.getEntityNamesInRange(center, radius)) {
+      /// @note Entities despawned after the snapshot are excluded.
+      if (entities_.count(name)) {
+        names.push_back(std::move(name));
+      }
+    }
+  }
+  for (const auto & name : entity_names_spawned_after_snapshot_) {
+    if (entities_.count(name) and std::find(names.begin(), names.end(), name) == names.end()) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
+auto EntityManager::getEntityId(const std::string & name) const -> std::uint64_t
+{
+  if (const auto iter = entity_ids_.find(name); iter != entity_ids_.end()) {
+    return iter->second;
+  } else {
+    THROW_SEMANTIC_ERROR("entity ", std::quoted(name), " does not exist.");
+  }
+}
+
 auto EntityManager::getEntity(const std::string & name) const
   -> std::shared_ptr<traffic_simulator::entity::EntityBase>
 {
@@ -166,6 +205,20 @@ auto EntityManager::getEntityStatus(const std::string & name) const -> Canonical
   }
 }
 
+auto EntityManager::getEntityStatuses() const -> std::vector<EntityStatus>
+{
+  std::vector<EntityStatus> entity_statuses;
+  entity_statuses.reserve(entities_.size());
+  for (const auto & [name, entity] : entities_) {
+    /// @note Same as getEntityStatus, except that the status is not canonicalized again.
+    auto & entity_status =
+      entity_statuses.emplace_back(static_cast<EntityStatus>(entity->getStatus()));
+    entity_status.action_status.current_action = entity->getCurrentAction();
+    entity_status.time = current_time_;
+  }
+  return entity_statuses;
+}
+
 auto EntityManager::getHdmapUtils() -> const std::shared_ptr<hdmap_utils::HdMapUtils> &
 {
   return hdmap_utils_ptr_;
@@ -337,8 +390,9 @@ void EntityManager::resetBehaviorPlugin(
 
 bool EntityManager::trafficLightsChanged()
 {
-  return conventional_traffic_light_manager_ptr_->hasAnyLightChanged() or
-         v2i_traffic_light_manager_ptr_->hasAnyLightChanged();
+  return not sent_conventional_traffic_lights_version_ or
+         conventional_traffic_light_manager_ptr_->hasAnyLightChanged(
+           sent_conventional_traffic_lights_version_.value());
 }
 
 void EntityManager::requestSpeedChange(
@@ -392,6 +446,48 @@ auto EntityManager::setEntityStatus(
   }
 }
 
+auto EntityManager::setEntityStatuses(const std::vector<EntityStatus> & statuses) -> void
+{
+  auto matched_statuses = statuses;
+  /**
+   * @note Entities are matched with the same inputs as EntityBase::fillLaneletPose, so that an
+   * entity does not switch lanelet where lanelets overlap. Pedestrians are matched including
+   * crosswalks, same as PedestrianEntity::fillLaneletPose.
+   */
+  for (const auto include_crosswalk : {false, true}) {
+    std::vector<std::size_t> indices;
+    std::vector<geometry_msgs::msg::Pose> poses;
+    std::vector<traffic_simulator_msgs::msg::BoundingBox> bounding_boxes;
+    std::vector<lanelet::Ids> route_lanelets;
+    for (std::size_t i = 0; i < statuses.size(); ++i) {
+      const auto & entity = entities_.at(statuses[i].name);
+      if (
+        is<PedestrianEntity>(statuses[i].name) == include_crosswalk and
+        statuses[i].pose != entity->getMapPose()) {
+        indices.push_back(i);
+        poses.push_back(statuses[i].pose);
+        bounding_boxes.push_back(entity->getBoundingBox());
+        /// @note Misc objects have no route, and MiscObjectEntity::getRouteLanelets throws.
+        route_lanelets.push_back(
+          is<MiscObjectEntity>(statuses[i].name)
+            ? lanelet::Ids()
+            : helper::getUniqueValues(entity->getRouteLanelets()));
+      }
+    }
+    const auto lanelet_poses = hdmap_utils_ptr_->toLaneletPoses(
+      poses, bounding_boxes, route_lanelets, include_crosswalk, 1.0,
+      entity_update_worker_pool_.get());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      auto & status = matched_statuses[indices[i]];
+      status.lanelet_pose_valid = static_cast<bool>(lanelet_poses[i]);
+      status.lanelet_pose = lanelet_poses[i] ? lanelet_poses[i].value() : LaneletPose();
+    }
+  }
+  for (const auto & status : matched_statuses) {
+    setEntityStatus(status.name, CanonicalizedEntityStatus(status, hdmap_utils_ptr_));
+  }
+}
+
 void EntityManager::setVerbose(const bool verbose)
 {
   configuration.verbose = verbose;
@@ -411,8 +507,10 @@ auto EntityManager::updateNpcLogic(const std::string & name) -> const Canonicali
   if (configuration.verbose) {
     std::cout << "update " << name << " behavior" << std::endl;
   }
-  entities_[name]->onUpdate(current_time_, step_time_);
-  return entities_[name]->getStatus();
+  /// @note Not operator[], which is not safe to call from multiple threads.
+  const auto & entity = entities_.at(name);
+  entity->onUpdate(current_time_, step_time_);
+  return entity->getStatus();
 }
 
 void EntityManager::update(const double current_time, const double step_time)
@@ -427,22 +525,49 @@ void EntityManager::update(const double current_time, const double step_time)
       configuration.conventional_traffic_light_publish_rate);
     v2i_traffic_light_updater_.createTimer(configuration.v2i_traffic_light_publish_rate);
   }
-  std::unordered_map<std::string, CanonicalizedEntityStatus> all_status;
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, entity->getStatus());
-  }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
-  }
-  all_status.clear();
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, updateNpcLogic(name));
-  }
-  for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+  /// @note Every entity shares the same immutable snapshot, instead of copying all statuses.
+  const auto share_entity_status_snapshot = [this](const auto & get_status) {
+    auto snapshot = std::make_shared<EntityStatusSnapshot>();
+    snapshot->version = ++entity_status_snapshot_version_;
+    for (auto && [name, entity] : entities_) {
+      snapshot->statuses.emplace(name, get_status(name));
+    }
+    for (auto && [name, entity] : entities_) {
+      entity->setOtherStatus(snapshot);
+    }
+    entity_status_snapshot_ = snapshot;
+    entity_names_spawned_after_snapshot_.clear();
+    return snapshot;
+  };
+  const auto get_status = [this](const auto & name) -> const CanonicalizedEntityStatus & {
+    return entities_.at(name)->getStatus();
+  };
+  share_entity_status_snapshot(get_status);
+  if (entity_update_worker_pool_) {
+    /**
+     * @note Entities only read other entities from the snapshot shared above and write their own
+     * status, so they can be updated in any order. Ego entities are updated on this thread, since
+     * they communicate with Autoware.
+     */
+    std::vector<std::string> names;
+    for (auto && [name, entity] : entities_) {
+      if (is<EgoEntity>(name)) {
+        updateNpcLogic(name);
+      } else {
+        names.push_back(name);
+      }
+    }
+    entity_update_worker_pool_->run(
+      names.size(), [&](const std::size_t index) { updateNpcLogic(names[index]); });
+  } else {
+    for (auto && [name, entity] : entities_) {
+      updateNpcLogic(name);
+    }
   }
+  /// @note Statuses are committed in the order of entities_, regardless of the update order.
+  const auto snapshot = share_entity_status_snapshot(get_status);
   traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray status_array_msg;
-  for (auto && [name, status] : all_status) {
+  for (auto && [name, status] : snapshot->statuses) {
     traffic_simulator_msgs::msg::EntityStatusWithTrajectory status_with_trajectory;
     status_with_trajectory.waypoint = getWaypoints(name);
     for (const auto & goal : getGoalPoses<geometry_msgs::msg::Pose>(name)) {
@@ -32,9 +32,8 @@ PedestrianEntity::PedestrianEntity(
 : EntityBase(name, entity_status, hdmap_utils_ptr),
   plugin_name(plugin_name),
   pedestrian_parameters(parameters),
-  loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
-    "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
-  behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
+  loader_(entity_behavior::getBehaviorPluginLoader()),
+  behavior_plugin_ptr_(loader_->createSharedInstance(plugin_name)),
   route_planner_(hdmap_utils_ptr_)
 {
   behavior_plugin_ptr_->configure(rclcpp::get_logger(name));
@@ -164,8 +163,11 @@ void PedestrianEntity::cancelRequest()
 
 auto PedestrianEntity::getEntityType() const -> const traffic_simulator_msgs::msg::EntityType &
 {
-  static traffic_simulator_msgs::msg::EntityType type;
-  type.type = traffic_simulator_msgs::msg::EntityType::PEDESTRIAN;
+  static const auto type = []() {
+    traffic_simulator_msgs::msg::EntityType type;
+    type.type = traffic_simulator_msgs::msg::EntityType::PEDESTRIAN;
+    return type;
+  }();
   return type;
 }
 
@@ -32,9 +32,8 @@ VehicleEntity::VehicleEntity(
   const std::string & plugin_name)
 : EntityBase(name, entity_status, hdmap_utils_ptr),
   vehicle_parameters(parameters),
-  loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
-    "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
-  behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
+  loader_(entity_behavior::getBehaviorPluginLoader()),
+  behavior_plugin_ptr_(loader_->createSharedInstance(plugin_name)),
   route_planner_(hdmap_utils_ptr_)
 {
   behavior_plugin_ptr_->configure(rclcpp::get_logger(name));
@@ -90,8 +89,11 @@ auto VehicleEntity::getBehaviorParameter() const -> traffic_simulator_msgs::msg:
 
 auto VehicleEntity::getEntityType() const -> const traffic_simulator_msgs::msg::EntityType &
 {
-  static traffic_simulator_msgs::msg::EntityType type;
-  type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  static const auto type = []() {
+    traffic_simulator_msgs::msg::EntityType type;
+    type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+    return type;
+  }();
   return type;
 }
 
@@ -26,7 +26,10 @@
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
+#include <cmath>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <geometry/linear_algebra.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <geometry/spline/hermite_curve.hpp>
@@ -37,6 +40,7 @@
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <lanelet2_extension/visualization/visualization.hpp>
+#include <map>
 #include <memory>
 #include <optional>
 #include <scenario_simulator_exception/exception.hpp>
@@ -44,6 +48,8 @@
 #include <string>
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/prebuilt_map.hpp>
+#include <traffic_simulator/hdmap_utils/shared_map_image.hpp>
 #include <traffic_simulator/helper/helper.hpp>
 #include <unordered_map>
 #include <utility>
@@ -52,24 +58,52 @@
 namespace hdmap_utils
 {
 HdMapUtils::HdMapUtils(
-  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &)
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin,
+  const std::size_t route_cache_capacity)
+: HdMapUtils(lanelet2_map_path, boost::filesystem::path(), origin, route_cache_capacity)
 {
-  lanelet::projection::MGRSProjector projector;
+}
+
+HdMapUtils::HdMapUtils(
+  const boost::filesystem::path & lanelet2_map_path,
+  const boost::filesystem::path & prebuilt_map_path, const geographic_msgs::msg::GeoPoint &,
+  const std::size_t route_cache_capacity)
+: route_cache_(route_cache_capacity)
+{
+  const auto prebuilt_map_key = prebuiltMapKey(lanelet2_map_path);
+
+  if (not prebuilt_map_path.empty()) {
+    if (lanelet_map_ptr_ = loadPrebuiltMap(prebuilt_map_key, prebuilt_map_path); lanelet_map_ptr_) {
+      prebuilt_map_path_ = prebuilt_map_path;
+    }
+  }
+
+  if (not lanelet_map_ptr_) {
+    prebuilt_map_path_ = prebuilt_map_key.cachePath();
+    if (lanelet_map_ptr_ = loadPrebuiltMap(prebuilt_map_key); not lanelet_map_ptr_) {
+      lanelet::projection::MGRSProjector projector;
 
-  lanelet::ErrorMessages errors;
+      lanelet::ErrorMessages errors;
 
-  lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
+      lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
 
-  if (not errors.empty()) {
-    std::stringstream ss;
-    const auto * separator = "";
-    for (const auto & error : errors) {
-      ss << separator << error;
-      separator = "\n";
+      if (not errors.empty()) {
+        std::stringstream ss;
+        const auto * separator = "";
+        for (const auto & error : errors) {
+          ss << separator << error;
+          separator = "\n";
+        }
+        THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
+      }
+      overwriteLaneletsCenterline();
+      savePrebuiltMap(prebuilt_map_key, *lanelet_map_ptr_);
+    }
+    /// @note simple_sensor_simulator uses the geometry of the map in place, without loading it.
+    if (not SharedMapImage::open(prebuilt_map_key, SharedMapImage::imagePath(prebuilt_map_path_))) {
+      SharedMapImage::save(prebuilt_map_key, *lanelet_map_ptr_);
     }
-    THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
   }
-  overwriteLaneletsCenterline();
   traffic_rules_vehicle_ptr_ = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Vehicle);
   vehicle_routing_graph_ptr_ =
@@ -83,6 +117,17 @@ HdMapUtils::HdMapUtils(
   all_graphs.push_back(pedestrian_routing_graph_ptr_);
   shoulder_lanelets_ =
     lanelet::utils::query::shoulderLanelets(lanelet::utils::query::laneletLayer(lanelet_map_ptr_));
+  calculateConflictingLaneletIds();
+  calculateTrafficLightRegulatoryElementIds();
+  lanelet_spatial_index_ = LaneletSpatialIndex(
+    lanelet_map_ptr_->laneletLayer,
+    [this](const auto & lanelet) { return getCenterPointsSpline(lanelet.id()); });
+}
+
+auto HdMapUtils::prebuiltMapKey(const boost::filesystem::path & lanelet2_map_path)
+  -> PrebuiltMapKey
+{
+  return PrebuiltMapKey(lanelet2_map_path, "MGRS", fine_centerline_resolution);
 }
 
 auto HdMapUtils::getAllCanonicalizedLaneletPoses(
@@ -255,16 +300,8 @@ auto HdMapUtils::getNearbyLaneletIds(
   const std::size_t search_count) const -> lanelet::Ids
 {
   lanelet::Ids lanelet_ids;
-  lanelet::BasicPoint2d search_point(position.x, position.y);
-  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelet =
-    lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, search_count);
-  if (nearest_lanelet.empty()) {
-    return {};
-  }
-  for (const auto & lanelet : nearest_lanelet) {
-    if (lanelet.first <= distance_threshold) {
-      lanelet_ids.emplace_back(lanelet.second.id());
-    }
+  for (const auto & lanelet : findNearbyLanelets(position, distance_threshold, search_count)) {
+    lanelet_ids.emplace_back(lanelet.second.id());
   }
   return lanelet_ids;
 }
@@ -274,37 +311,92 @@ auto HdMapUtils::getNearbyLaneletIds(
   const bool include_crosswalk, const std::size_t search_count) const -> lanelet::Ids
 {
   lanelet::Ids lanelet_ids;
-  lanelet::BasicPoint2d search_point(point.x, point.y);
-  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelet =
-    lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, search_count);
+  const auto nearest_lanelet = findNearbyLanelets(point, distance_thresh, search_count);
   if (include_crosswalk) {
-    if (nearest_lanelet.empty()) {
-      return {};
-    }
-    if (nearest_lanelet.front().first > distance_thresh) {
-      return {};
-    }
     for (const auto & lanelet : nearest_lanelet) {
-      if (lanelet.first <= distance_thresh) {
-        lanelet_ids.emplace_back(lanelet.second.id());
-      }
+      lanelet_ids.emplace_back(lanelet.second.id());
     }
   } else {
-    const auto nearest_road_lanelet =
-      excludeSubtypeLanelets(nearest_lanelet, lanelet::AttributeValueString::Crosswalk);
-    if (nearest_road_lanelet.empty()) {
-      return {};
+    for (const auto & lanelet :
+         excludeSubtypeLanelets(nearest_lanelet, lanelet::AttributeValueString::Crosswalk)) {
+      lanelet_ids.emplace_back(lanelet.second.id());
     }
-    if (nearest_road_lanelet.front().first > distance_thresh) {
-      return {};
+  }
+  return lanelet_ids;
+}
+
+auto HdMapUtils::findNearbyLanelets(
+  const geometry_msgs::msg::Point & point, const double distance_threshold,
+  const std::size_t search_count) const -> std::vector<std::pair<double, lanelet::Lanelet>>
+{
+  return findNearbyLanelets(point, distance_threshold, search_count, lanelet_spatial_index_);
+}
+
+auto HdMapUtils::findNearbyLanelets(
+  const geometry_msgs::msg::Point & point, const double distance_threshold,
+  const std::size_t search_count, const LaneletSpatialIndex & spatial_index) const
+  -> std::vector<std::pair<double, lanelet::Lanelet>>
+{
+  /**
+   * @note Same result as lanelet::geometry::findNearest with the search_count followed by
+   * dropping lanelets farther than the distance_threshold, but only lanelets whose bounding box is
+   * within the distance_threshold have their exact distance calculated.
+   */
+  const lanelet::BasicPoint2d search_point(point.x, point.y);
+  std::vector<std::pair<double, lanelet::Lanelet>> nearby_lanelets;
+  for (const auto lanelet_id : spatial_index.getLaneletIds(point, distance_threshold)) {
+    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
+    if (const auto distance = lanelet::geometry::distance2d(lanelet, search_point);
+        distance <= distance_threshold) {
+      nearby_lanelets.emplace_back(distance, lanelet);
     }
-    for (const auto & lanelet : nearest_road_lanelet) {
-      if (lanelet.first <= distance_thresh) {
-        lanelet_ids.emplace_back(lanelet.second.id());
-      }
+  }
+  std::sort(nearby_lanelets.begin(), nearby_lanelets.end(), [](const auto & lhs, const auto & rhs) {
+    return lhs.first < rhs.first;
+  });
+  if (nearby_lanelets.size() > search_count) {
+    nearby_lanelets.resize(search_count);
+  }
+  return nearby_lanelets;
+}
+
+auto HdMapUtils::getMatchingCandidateLaneletIds(
+  const geometry_msgs::msg::Pose & pose, const bool include_crosswalk,
+  const double matching_distance) const -> lanelet::Ids
+{
+  return getMatchingCandidateLaneletIds(
+    pose, include_crosswalk, matching_distance, lanelet_spatial_index_);
+}
+
+auto HdMapUtils::getMatchingCandidateLaneletIds(
+  const geometry_msgs::msg::Pose & pose, const bool include_crosswalk,
+  const double matching_distance, const LaneletSpatialIndex & spatial_index) const -> lanelet::Ids
+{
+  /// @note Same lanelets as getNearbyLaneletIds(pose.position, 0.1, include_crosswalk).
+  auto nearby_lanelets = findNearbyLanelets(pose.position, 0.1, 5, spatial_index);
+  if (not include_crosswalk) {
+    nearby_lanelets =
+      excludeSubtypeLanelets(nearby_lanelets, lanelet::AttributeValueString::Crosswalk);
+  }
+  if (nearby_lanelets.empty()) {
+    return {};
+  }
+  lanelet::Ids lanelet_ids;
+  for (const auto & lanelet : nearby_lanelets) {
+    lanelet_ids.emplace_back(lanelet.second.id());
+  }
+  /// @note Try the lanelets in order of the distance to their nearest curve.
+  lanelet::Ids sorted_lanelet_ids;
+  for (const auto & [distance, curve] :
+       spatial_index.getCurves(pose.position, matching_distance)) {
+    if (
+      std::find(lanelet_ids.begin(), lanelet_ids.end(), curve.lanelet_id) != lanelet_ids.end() and
+      std::find(sorted_lanelet_ids.begin(), sorted_lanelet_ids.end(), curve.lanelet_id) ==
+        sorted_lanelet_ids.end()) {
+      sorted_lanelet_ids.emplace_back(curve.lanelet_id);
     }
   }
-  return lanelet_ids;
+  return sorted_lanelet_ids;
 }
 
 auto HdMapUtils::getHeight(const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose) const
@@ -366,12 +458,7 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 {
   lanelet::Ids ids;
   for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-    const auto conflicting_lanelets =
-      lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet);
-    for (const auto & conflicting_lanelet : conflicting_lanelets) {
-      ids.emplace_back(conflicting_lanelet.id());
-    }
+    ids += conflicting_lane_ids_.at(lanelet_id);
   }
   return ids;
 }
@@ -379,21 +466,32 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 auto HdMapUtils::getConflictingCrosswalkIds(const lanelet::Ids & lanelet_ids) const -> lanelet::Ids
 {
   lanelet::Ids ids;
+  for (const auto & lanelet_id : lanelet_ids) {
+    ids += conflicting_crosswalk_ids_.at(lanelet_id);
+  }
+  return ids;
+}
+
+auto HdMapUtils::calculateConflictingLaneletIds() -> void
+{
   std::vector<lanelet::routing::RoutingGraphConstPtr> graphs;
   graphs.emplace_back(vehicle_routing_graph_ptr_);
   graphs.emplace_back(pedestrian_routing_graph_ptr_);
   lanelet::routing::RoutingGraphContainer container(graphs);
-  for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    auto & lane_ids = conflicting_lane_ids_[lanelet.id()];
+    for (const auto & conflicting_lanelet :
+         lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet)) {
+      lane_ids.emplace_back(conflicting_lanelet.id());
+    }
     double height_clearance = 4;
     size_t routing_graph_id = 1;
-    const auto conflicting_crosswalks =
-      container.conflictingInGraph(lanelet, routing_graph_id, height_clearance);
-    for (const auto & crosswalk : conflicting_crosswalks) {
-      ids.emplace_back(crosswalk.id());
+    auto & crosswalk_ids = conflicting_crosswalk_ids_[lanelet.id()];
+    for (const auto & crosswalk :
+         container.conflictingInGraph(lanelet, routing_graph_id, height_clearance)) {
+      crosswalk_ids.emplace_back(crosswalk.id());
     }
   }
-  return ids;
 }
 
 auto HdMapUtils::clipTrajectoryFromLaneletIds(
@@ -541,11 +639,7 @@ auto HdMapUtils::toLaneletPose(
   const geometry_msgs::msg::Pose & pose, const bool include_crosswalk,
   const double matching_distance) const -> std::optional<traffic_simulator_msgs::msg::LaneletPose>
 {
-  const auto lanelet_ids = getNearbyLaneletIds(pose.position, 0.1, include_crosswalk);
-  if (lanelet_ids.empty()) {
-    return std::nullopt;
-  }
-  for (const auto & id : lanelet_ids) {
+  for (const auto id : getMatchingCandidateLaneletIds(pose, include_crosswalk, matching_distance)) {
     const auto lanelet_pose = toLaneletPose(pose, id, matching_distance);
     if (lanelet_pose) {
       return lanelet_pose;
@@ -558,15 +652,22 @@ auto HdMapUtils::toLaneletPose(
   const geometry_msgs::msg::Pose & pose, const lanelet::Id lanelet_id,
   const double matching_distance) const -> std::optional<traffic_simulator_msgs::msg::LaneletPose>
 {
-  const auto spline = getCenterPointsSpline(lanelet_id);
-  const auto s = spline->getSValue(pose, matching_distance);
+  return toLaneletPose(pose, lanelet_id, *getCenterPointsSpline(lanelet_id), matching_distance);
+}
+
+auto HdMapUtils::toLaneletPose(
+  const geometry_msgs::msg::Pose & pose, const lanelet::Id lanelet_id,
+  const math::geometry::CatmullRomSpline & spline, const double matching_distance) const
+  -> std::optional<traffic_simulator_msgs::msg::LaneletPose>
+{
+  const auto s = spline.getSValue(pose, matching_distance);
   if (!s) {
     return std::nullopt;
   }
-  auto pose_on_centerline = spline->getPose(s.value());
+  auto pose_on_centerline = spline.getPose(s.value());
   auto rpy = quaternion_operation::convertQuaternionToEulerAngle(
     quaternion_operation::getRotation(pose_on_centerline.orientation, pose.orientation));
-  double offset = std::sqrt(spline->getSquaredDistanceIn2D(pose.position, s.value()));
+  double offset = std::sqrt(spline.getSquaredDistanceIn2D(pose.position, s.value()));
   /**
    * @note Hard coded parameter
    */
@@ -575,7 +676,7 @@ auto HdMapUtils::toLaneletPose(
     return std::nullopt;
   }
   double inner_prod = math::geometry::innerProduct(
-    spline->getNormalVector(s.value()), spline->getSquaredDistanceVector(pose.position, s.value()));
+    spline.getNormalVector(s.value()), spline.getSquaredDistanceVector(pose.position, s.value()));
   if (inner_prod < 0) {
     offset = offset * -1;
   }
@@ -629,6 +730,126 @@ auto HdMapUtils::toLaneletPose(
   return toLaneletPose(pose, include_crosswalk);
 }
 
+auto HdMapUtils::toLaneletPose(
+  const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox,
+  const lanelet::Ids & route_lanelets, const bool include_crosswalk,
+  const double matching_distance) const -> std::optional<traffic_simulator_msgs::msg::LaneletPose>
+{
+  if (const auto lanelet_pose = toLaneletPose(pose, route_lanelets, matching_distance)) {
+    return lanelet_pose;
+  }
+  return toLaneletPose(pose, bbox, include_crosswalk, matching_distance);
+}
+
+auto HdMapUtils::toLaneletPoses(
+  const std::vector<geometry_msgs::msg::Pose> & poses, const bool include_crosswalk,
+  const double matching_distance, traffic_simulator::WorkerPool * worker_pool) const
+  -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>
+{
+  const auto run = [&](const std::size_t size, const std::function<void(std::size_t)> & function) {
+    if (worker_pool) {
+      worker_pool->run(size, function);
+    } else {
+      for (std::size_t i = 0; i < size; ++i) {
+        function(i);
+      }
+    }
+  };
+
+  /**
+   * @note Poses close to each other share one query of the spatial index for their candidates.
+   * The subset of the index gives the same candidates as the whole index, because its query
+   * distance covers both the distance to the lanelets and the matching distance.
+   */
+  constexpr double cell_size = 10.0;
+  std::map<std::pair<std::int64_t, std::int64_t>, std::vector<std::size_t>> cells;
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    const auto cell = std::make_pair(
+      static_cast<std::int64_t>(std::floor(poses[i].position.x / cell_size)),
+      static_cast<std::int64_t>(std::floor(poses[i].position.y / cell_size)));
+    cells[cell].push_back(i);
+  }
+  std::vector<const std::vector<std::size_t> *> cell_indices;
+  for (const auto & [cell, indices] : cells) {
+    cell_indices.push_back(&indices);
+  }
+  std::vector<lanelet::Ids> candidates(poses.size());
+  run(cell_indices.size(), [&](const std::size_t cell) {
+    const auto & indices = *cell_indices[cell];
+    if (indices.size() == 1) {
+      candidates[indices.front()] = getMatchingCandidateLaneletIds(
+        poses[indices.front()], include_crosswalk, matching_distance, lanelet_spatial_index_);
+    } else {
+      std::vector<geometry_msgs::msg::Point> points;
+      for (const auto i : indices) {
+        points.push_back(poses[i].position);
+      }
+      const auto subset =
+        lanelet_spatial_index_.getSubset(points, std::max(0.1, matching_distance));
+      for (const auto i : indices) {
+        candidates[i] =
+          getMatchingCandidateLaneletIds(poses[i], include_crosswalk, matching_distance, subset);
+      }
+    }
+  });
+
+  /**
+   * @note Poses are matched to their first candidates, then the unmatched ones to their second
+   * candidates and so on, which gives the same result as matching each pose alone. In each round,
+   * poses with the same candidate lanelet are matched together with one lookup of its spline.
+   */
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> ret(poses.size());
+  for (std::size_t rank = 0;; ++rank) {
+    std::map<lanelet::Id, std::vector<std::size_t>> lanelets;
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      if (not ret[i] and rank < candidates[i].size()) {
+        lanelets[candidates[i][rank]].push_back(i);
+      }
+    }
+    if (lanelets.empty()) {
+      return ret;
+    }
+    std::vector<std::pair<lanelet::Id, const std::vector<std::size_t> *>> lanelet_indices;
+    for (const auto & [lanelet_id, indices] : lanelets) {
+      lanelet_indices.emplace_back(lanelet_id, &indices);
+    }
+    run(lanelet_indices.size(), [&](const std::size_t lanelet) {
+      const auto & [lanelet_id, indices] = lanelet_indices[lanelet];
+      const auto spline = getCenterPointsSpline(lanelet_id);
+      for (const auto i : *indices) {
+        ret[i] = toLaneletPose(poses[i], lanelet_id, *spline, matching_distance);
+      }
+    });
+  }
+}
+
+auto HdMapUtils::toLaneletPoses(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const std::vector<traffic_simulator_msgs::msg::BoundingBox> & bboxes,
+  const std::vector<lanelet::Ids> & route_lanelets, const bool include_crosswalk,
+  const double matching_distance, traffic_simulator::WorkerPool * worker_pool) const
+  -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>
+{
+  if (bboxes.size() != poses.size() or route_lanelets.size() != poses.size()) {
+    THROW_SIMULATION_ERROR(
+      "Number of bounding boxes ", bboxes.size(), " and route lanelets ", route_lanelets.size(),
+      " must be the same as that of poses ", poses.size(), ".");
+  }
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> ret(poses.size());
+  const auto match = [&](const std::size_t i) {
+    ret[i] =
+      toLaneletPose(poses[i], bboxes[i], route_lanelets[i], include_crosswalk, matching_distance);
+  };
+  if (worker_pool) {
+    worker_pool->run(poses.size(), match);
+  } else {
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      match(i);
+    }
+  }
+  return ret;
+}
+
 auto HdMapUtils::toLaneletPoses(
   const geometry_msgs::msg::Pose & pose, const lanelet::Id lanelet_id,
   const double matching_distance, const bool include_opposite_direction) const
@@ -654,9 +875,7 @@ auto HdMapUtils::getClosestLaneletId(
   const geometry_msgs::msg::Pose & pose, const double distance_thresh,
   const bool include_crosswalk) const -> std::optional<lanelet::Id>
 {
-  lanelet::BasicPoint2d search_point(pose.position.x, pose.position.y);
-  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelet =
-    lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, 3);
+  const auto nearest_lanelet = findNearbyLanelets(pose.position, distance_thresh, 3);
   if (include_crosswalk) {
     if (nearest_lanelet.empty()) {
       return std::nullopt;
@@ -744,6 +963,11 @@ auto HdMapUtils::getLaneChangeableLaneletId(
   return target;
 }
 
+auto HdMapUtils::getPrebuiltMapPath() const -> const boost::filesystem::path &
+{
+  return prebuilt_map_path_;
+}
+
 auto HdMapUtils::getPreviousLanelets(const lanelet::Id lanelet_id, const double distance) const
   -> lanelet::Ids
 {
@@ -848,8 +1072,8 @@ auto HdMapUtils::getRoute(
   const lanelet::Id from_lanelet_id, const lanelet::Id to_lanelet_id, bool allow_lane_change) const
   -> lanelet::Ids
 {
-  if (route_cache_.exists(from_lanelet_id, to_lanelet_id, allow_lane_change)) {
-    return route_cache_.getRoute(from_lanelet_id, to_lanelet_id, allow_lane_change);
+  if (auto route = route_cache_.getRoute(from_lanelet_id, to_lanelet_id, allow_lane_change)) {
+    return route.value();
   }
   lanelet::Ids ids;
   const auto lanelet = lanelet_map_ptr_->laneletLayer.get(from_lanelet_id);
@@ -875,8 +1099,17 @@ auto HdMapUtils::getRoute(
 auto HdMapUtils::getCenterPointsSpline(const lanelet::Id lanelet_id) const
   -> std::shared_ptr<math::geometry::CatmullRomSpline>
 {
-  getCenterPoints(lanelet_id);
-  return center_points_cache_.getCenterPointsSpline(lanelet_id);
+  if (!lanelet_map_ptr_) {
+    THROW_SIMULATION_ERROR("lanelet map is null pointer");
+  }
+  if (lanelet_map_ptr_->laneletLayer.empty()) {
+    THROW_SIMULATION_ERROR("lanelet layer is empty");
+  }
+  if (auto spline = center_points_cache_.getCenterPointsSpline(lanelet_id)) {
+    return spline;
+  }
+  return center_points_cache_.appendData(
+    lanelet_id, calculateCenterPoints(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
 }
 
 auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
@@ -896,18 +1129,13 @@ auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
 auto HdMapUtils::getCenterPoints(const lanelet::Id lanelet_id) const
   -> std::vector<geometry_msgs::msg::Point>
 {
-  std::vector<geometry_msgs::msg::Point> ret;
-  if (!lanelet_map_ptr_) {
-    THROW_SIMULATION_ERROR("lanelet map is null pointer");
-  }
-  if (lanelet_map_ptr_->laneletLayer.empty()) {
-    THROW_SIMULATION_ERROR("lanelet layer is empty");
-  }
-  if (center_points_cache_.exists(lanelet_id)) {
-    return center_points_cache_.getCenterPoints(lanelet_id);
-  }
+  return getCenterPointsSpline(lanelet_id)->control_points;
+}
 
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
+auto HdMapUtils::calculateCenterPoints(const lanelet::ConstLanelet & lanelet) const
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  std::vector<geometry_msgs::msg::Point> ret;
   const auto centerline = lanelet.centerline();
   for (const auto & point : centerline) {
     geometry_msgs::msg::Point p;
@@ -928,14 +1156,13 @@ auto HdMapUtils::getCenterPoints(const lanelet::Id lanelet_id) const
     ret.push_back(p1);
     ret.push_back(p2);
   }
-  center_points_cache_.appendData(lanelet_id, ret);
   return ret;
 }
 
 auto HdMapUtils::getLaneletLength(const lanelet::Id lanelet_id) const -> double
 {
-  if (lanelet_length_cache_.exists(lanelet_id)) {
-    return lanelet_length_cache_.getLength(lanelet_id);
+  if (const auto length = lanelet_length_cache_.getLength(lanelet_id)) {
+    return length.value();
   }
   double ret = lanelet::utils::getLaneletLength2d(lanelet_map_ptr_->laneletLayer.get(lanelet_id));
   lanelet_length_cache_.appendData(lanelet_id, ret);
@@ -1196,6 +1423,19 @@ auto HdMapUtils::getLeftLaneletIds(
   }
 }
 
+auto HdMapUtils::getLineStrings(const std::vector<std::string> & types) const
+  -> std::vector<std::vector<geometry_msgs::msg::Point>>
+{
+  std::vector<std::vector<geometry_msgs::msg::Point>> line_strings;
+  for (const auto & line_string : lanelet_map_ptr_->lineStringLayer) {
+    if (const auto type = line_string.attributeOr(lanelet::AttributeName::Type, "");
+        std::find(types.begin(), types.end(), type) != types.end()) {
+      line_strings.push_back(toPolygon(line_string));
+    }
+  }
+  return line_strings;
+}
+
 auto HdMapUtils::getRightLaneletIds(
   lanelet::Id lanelet_id, traffic_simulator_msgs::msg::EntityType type,
   bool include_opposite_direction) const -> lanelet::Ids
@@ -1450,30 +1690,12 @@ auto HdMapUtils::getLateralDistance(
   if (allow_lane_change) {
     double lateral_distance_by_lane_change = 0.0;
     for (unsigned int i = 0; i < route.size() - 1; i++) {
-      auto next_lanelet_ids = getNextLaneletIds(route[i]);
-      if (auto next_lanelet = std::find_if(
-            next_lanelet_ids.begin(), next_lanelet_ids.end(),
-            [&route, i](const lanelet::Id & id) { return id == route[i + 1]; });
-          next_lanelet == next_lanelet_ids.end()) {
-        traffic_simulator_msgs::msg::LaneletPose next_lanelet_pose;
-        next_lanelet_pose.lanelet_id = route[i + 1];
-        next_lanelet_pose.s = 0.0;
-        next_lanelet_pose.offset = 0.0;
-
-        if (
-          auto next_lanelet_origin_from_current_lanelet =
-            toLaneletPose(toMapPose(next_lanelet_pose).pose, route[i], 10.0)) {
-          lateral_distance_by_lane_change += next_lanelet_origin_from_current_lanelet->offset;
+      if (const auto transition = getLaneletTransition(route[i], route[i + 1]);
+          transition.is_lane_change) {
+        if (transition.displacement) {
+          lateral_distance_by_lane_change += transition.displacement->offset;
         } else {
-          traffic_simulator_msgs::msg::LaneletPose current_lanelet_pose = next_lanelet_pose;
-          current_lanelet_pose.lanelet_id = route[i];
-          if (
-            auto current_lanelet_origin_from_next_lanelet =
-              toLaneletPose(toMapPose(current_lanelet_pose).pose, route[i + 1], 10.0)) {
-            lateral_distance_by_lane_change -= current_lanelet_origin_from_next_lanelet->offset;
-          } else {
-            return std::nullopt;
-          }
+          return std::nullopt;
         }
       }
     }
@@ -1504,15 +1726,7 @@ auto HdMapUtils::getLongitudinalDistance(
   auto with_lane_change = [this](
                             const bool allow_lane_change, const lanelet::Id current_lanelet,
                             const lanelet::Id next_lanelet) -> bool {
-    if (allow_lane_change) {
-      auto next_lanelet_ids = getNextLaneletIds(current_lanelet);
-      auto next_lanelet_itr = std::find_if(
-        next_lanelet_ids.begin(), next_lanelet_ids.end(),
-        [next_lanelet](const lanelet::Id & id) { return id == next_lanelet; });
-      return next_lanelet_itr == next_lanelet_ids.end();
-    } else {
-      return false;
-    }
+    return allow_lane_change and getLaneletTransition(current_lanelet, next_lanelet).is_lane_change;
   };
 
   /// @note in this for loop, some cases are marked by @note command. each case is explained in the document.
@@ -1520,25 +1734,11 @@ auto HdMapUtils::getLongitudinalDistance(
   for (unsigned int i = 0; i < route.size(); i++) {
     if (i < route.size() - 1 && with_lane_change(allow_lane_change, route[i], route[i + 1])) {
       /// @note "the lanelet before the lane change" case
-      traffic_simulator_msgs::msg::LaneletPose next_lanelet_pose;
-      next_lanelet_pose.lanelet_id = route[i + 1];
-      next_lanelet_pose.s = 0.0;
-      next_lanelet_pose.offset = 0.0;
-
-      if (
-        auto next_lanelet_origin_from_current_lanelet =
-          toLaneletPose(toMapPose(next_lanelet_pose).pose, route[i], 10.0)) {
-        distance += next_lanelet_origin_from_current_lanelet->s;
+      if (const auto transition = getLaneletTransition(route[i], route[i + 1]);
+          transition.displacement) {
+        distance += transition.displacement->s;
       } else {
-        traffic_simulator_msgs::msg::LaneletPose current_lanelet_pose = next_lanelet_pose;
-        current_lanelet_pose.lanelet_id = route[i];
-        if (
-          auto current_lanelet_origin_from_next_lanelet =
-            toLaneletPose(toMapPose(current_lanelet_pose).pose, route[i + 1], 10.0)) {
-          distance -= current_lanelet_origin_from_next_lanelet->s;
-        } else {
-          return std::nullopt;
-        }
+        return std::nullopt;
       }
 
       /// @note "first lanelet before the lane change" case
@@ -1565,6 +1765,43 @@ auto HdMapUtils::getLongitudinalDistance(
   return distance;
 }
 
+auto HdMapUtils::getLaneletTransition(const lanelet::Id from, const lanelet::Id to) const
+  -> LaneletTransition
+{
+  if (auto transition = lanelet_transition_cache_.getTransition(from, to)) {
+    return transition.value();
+  }
+  LaneletTransition transition;
+  const auto next_lanelet_ids = getNextLaneletIds(from);
+  transition.is_lane_change =
+    std::find(next_lanelet_ids.begin(), next_lanelet_ids.end(), to) == next_lanelet_ids.end();
+  if (transition.is_lane_change) {
+    traffic_simulator_msgs::msg::LaneletPose next_lanelet_pose;
+    next_lanelet_pose.lanelet_id = to;
+    next_lanelet_pose.s = 0.0;
+    next_lanelet_pose.offset = 0.0;
+    if (
+      const auto next_lanelet_origin_from_current_lanelet =
+        toLaneletPose(toMapPose(next_lanelet_pose).pose, from, 10.0)) {
+      transition.displacement = LaneletTransition::Displacement{
+        next_lanelet_origin_from_current_lanelet->s,
+        next_lanelet_origin_from_current_lanelet->offset};
+    } else {
+      traffic_simulator_msgs::msg::LaneletPose current_lanelet_pose = next_lanelet_pose;
+      current_lanelet_pose.lanelet_id = from;
+      if (
+        const auto current_lanelet_origin_from_next_lanelet =
+          toLaneletPose(toMapPose(current_lanelet_pose).pose, to, 10.0)) {
+        transition.displacement = LaneletTransition::Displacement{
+          -current_lanelet_origin_from_next_lanelet->s,
+          -current_lanelet_origin_from_next_lanelet->offset};
+      }
+    }
+  }
+  lanelet_transition_cache_.appendData(from, to, transition);
+  return transition;
+}
+
 auto HdMapUtils::toMapBin() const -> autoware_auto_mapping_msgs::msg::HADMapBin
 {
   std::stringstream ss;
@@ -1652,7 +1889,8 @@ auto HdMapUtils::overwriteLaneletsCenterline() -> void
 {
   for (auto & lanelet_obj : lanelet_map_ptr_->laneletLayer) {
     if (!lanelet_obj.hasCustomCenterline()) {
-      const auto fine_center_line = generateFineCenterline(lanelet_obj, 2.0);
+      const auto fine_center_line =
+        generateFineCenterline(lanelet_obj, fine_centerline_resolution);
       lanelet_obj.setCenterline(fine_center_line);
     }
   }
@@ -2170,18 +2408,23 @@ auto HdMapUtils::getTrafficLightRegulatoryElementIDsFromTrafficLight(
   const lanelet::Id traffic_light_way_id) const -> lanelet::Ids
 {
   assert(isTrafficLight(traffic_light_way_id));
-  lanelet::Ids traffic_light_regulatory_element_ids;
+  if (const auto iter = traffic_light_regulatory_element_ids_.find(traffic_light_way_id);
+      iter != traffic_light_regulatory_element_ids_.end()) {
+    return iter->second;
+  }
+  return {};
+}
+
+auto HdMapUtils::calculateTrafficLightRegulatoryElementIds() -> void
+{
   for (const auto & regulatory_element : lanelet_map_ptr_->regulatoryElementLayer) {
     if (regulatory_element->attribute(lanelet::AttributeName::Subtype).value() == "traffic_light") {
       for (const auto & ref_member :
            regulatory_element->getParameters<lanelet::ConstLineString3d>("refers")) {
-        if (ref_member.id() == traffic_light_way_id) {
-          traffic_light_regulatory_element_ids.push_back(regulatory_element->id());
-        }
+        traffic_light_regulatory_element_ids_[ref_member.id()].push_back(regulatory_element->id());
       }
     }
   }
-  return traffic_light_regulatory_element_ids;
 }
 
 auto HdMapUtils::toPolygon(const lanelet::ConstLineString3d & line_string) const
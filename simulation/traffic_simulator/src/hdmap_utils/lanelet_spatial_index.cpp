@@ -0,0 +1,122 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <iterator>
+#include <traffic_simulator/hdmap_utils/lanelet_spatial_index.hpp>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace hdmap_utils
+{
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+LaneletSpatialIndex::LaneletSpatialIndex(
+  const lanelet::LaneletLayer & lanelet_layer,
+  const CenterPointsSplineFunction & get_center_points_spline)
+{
+  std::vector<CurveValue> curves;
+  std::vector<LaneletValue> lanelets;
+
+  const auto to_point = [](const auto & point) { return Point(point.x, point.y); };
+
+  for (const auto & lanelet : lanelet_layer) {
+    const auto spline = get_center_points_spline(lanelet);
+    const auto & center_points = spline->control_points;
+    const auto & bounding_boxes = spline->getCurveBoundingBoxes();
+    for (std::size_t i = 0; i < bounding_boxes.size(); ++i) {
+      const auto & [min_corner, max_corner] = bounding_boxes[i];
+      curves.emplace_back(
+        Box(to_point(min_corner), to_point(max_corner)),
+        Curve{
+          lanelet.id(), i, Segment(to_point(center_points[i]), to_point(center_points[i + 1]))});
+    }
+    Box envelope;
+    bg::assign_inverse(envelope);
+    for (const auto & point : lanelet.polygon2d()) {
+      bg::expand(envelope, Point(point.x(), point.y()));
+    }
+    lanelets.emplace_back(envelope, lanelet.id());
+  }
+
+  *this = LaneletSpatialIndex(std::move(curves), std::move(lanelets));
+}
+
+LaneletSpatialIndex::LaneletSpatialIndex(
+  std::vector<CurveValue> && curves, std::vector<LaneletValue> && lanelets)
+/// @note Constructing from a range uses the packing algorithm, which gives a better tree.
+: curves_(curves.begin(), curves.end()), lanelets_(lanelets.begin(), lanelets.end())
+{
+}
+
+auto LaneletSpatialIndex::makeQueryBox(
+  const geometry_msgs::msg::Point & point, const double distance) -> Box
+{
+  /// @note Margin for the tolerance of the root finding in math::geometry::HermiteCurve.
+  constexpr double margin = 1e-3;
+  return Box(
+    Point(point.x - distance - margin, point.y - distance - margin),
+    Point(point.x + distance + margin, point.y + distance + margin));
+}
+
+auto LaneletSpatialIndex::getCurves(const geometry_msgs::msg::Point & point, const double distance)
+  const -> std::vector<std::pair<double, Curve>>
+{
+  std::vector<CurveValue> values;
+  curves_.query(bgi::intersects(makeQueryBox(point, distance)), std::back_inserter(values));
+  std::vector<std::pair<double, Curve>> ret;
+  ret.reserve(values.size());
+  for (const auto & [box, curve] : values) {
+    ret.emplace_back(bg::distance(Point(point.x, point.y), curve.chord), curve);
+  }
+  /// @note Ties are broken, so that the order does not depend on the structure of the tree.
+  std::sort(ret.begin(), ret.end(), [](const auto & lhs, const auto & rhs) {
+    return std::tie(lhs.first, lhs.second.lanelet_id, lhs.second.index) <
+           std::tie(rhs.first, rhs.second.lanelet_id, rhs.second.index);
+  });
+  return ret;
+}
+
+auto LaneletSpatialIndex::getLaneletIds(
+  const geometry_msgs::msg::Point & point, const double distance) const -> lanelet::Ids
+{
+  std::vector<LaneletValue> values;
+  lanelets_.query(bgi::intersects(makeQueryBox(point, distance)), std::back_inserter(values));
+  lanelet::Ids ret;
+  ret.reserve(values.size());
+  for (const auto & [box, lanelet_id] : values) {
+    ret.push_back(lanelet_id);
+  }
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+auto LaneletSpatialIndex::getSubset(
+  const std::vector<geometry_msgs::msg::Point> & points, const double distance) const
+  -> LaneletSpatialIndex
+{
+  Box query_box;
+  bg::assign_inverse(query_box);
+  for (const auto & point : points) {
+    bg::expand(query_box, makeQueryBox(point, distance));
+  }
+  std::vector<CurveValue> curves;
+  curves_.query(bgi::intersects(query_box), std::back_inserter(curves));
+  std::vector<LaneletValue> lanelets;
+  lanelets_.query(bgi::intersects(query_box), std::back_inserter(lanelets));
+  return LaneletSpatialIndex(std::move(curves), std::move(lanelets));
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,152 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <lanelet2_io/io_handlers/Serialize.h>
+
+#include <array>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <sstream>
+#include <string>
+#include <traffic_simulator/hdmap_utils/prebuilt_map.hpp>
+
+namespace hdmap_utils
+{
+namespace
+{
+/// @note 64-bit FNV-1a. Stable across processes and builds, unlike std::hash.
+auto hashFileContents(const boost::filesystem::path & path) -> std::uint64_t
+{
+  std::ifstream file(path.string(), std::ios::binary);
+  if (not file) {
+    THROW_SIMULATION_ERROR("Failed to open lanelet map ", std::quoted(path.string()));
+  }
+  std::uint64_t hash = 0xcbf29ce484222325;
+  std::array<char, 1 << 16> buffer;
+  while (file.read(buffer.data(), buffer.size()) or file.gcount() > 0) {
+    for (std::streamsize i = 0; i < file.gcount(); ++i) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 0x100000001b3;
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
+PrebuiltMapKey::PrebuiltMapKey(
+  const boost::filesystem::path & lanelet2_map_path, const std::string & projector,
+  const double centerline_resolution)
+: lanelet2_map_path(lanelet2_map_path),
+  lanelet2_map_hash(hashFileContents(lanelet2_map_path)),
+  projector(projector),
+  centerline_resolution(centerline_resolution)
+{
+}
+
+auto PrebuiltMapKey::cachePath() const -> boost::filesystem::path
+{
+  /// @note Every field of the key is part of the name, so keys never overwrite each other's file.
+  std::stringstream filename;
+  filename << lanelet2_map_path.stem().string() << "-" << std::hex << std::setw(16)
+           << std::setfill('0') << lanelet2_map_hash << "-" << projector << "-" << std::hexfloat
+           << centerline_resolution << "-v" << std::dec << format_version << ".bin";
+  return boost::filesystem::temp_directory_path() / "scenario_simulator_v2" / "prebuilt_map" /
+         filename.str();
+}
+
+auto PrebuiltMapKey::operator==(const PrebuiltMapKey & other) const -> bool
+{
+  return lanelet2_map_hash == other.lanelet2_map_hash and projector == other.projector and
+         centerline_resolution == other.centerline_resolution;
+}
+
+auto loadPrebuiltMap(const PrebuiltMapKey & key) -> lanelet::LaneletMapPtr
+{
+  return loadPrebuiltMap(key, key.cachePath());
+}
+
+/**
+ * @note The cache file is mapped read-only and deserialized straight from the mapping, without
+ * copying it into an intermediate buffer. The deserialized map is private to each process; see
+ * SharedMapImage for the geometry that is shared between processes.
+ */
+auto loadPrebuiltMap(const PrebuiltMapKey & key, const boost::filesystem::path & cache_path)
+  -> lanelet::LaneletMapPtr
+try {
+  if (not boost::filesystem::is_regular_file(cache_path)) {
+    return nullptr;
+  }
+  const boost::iostreams::mapped_file_source file(cache_path.string());
+  boost::iostreams::stream<boost::iostreams::array_source> stream(file.data(), file.size());
+  boost::archive::binary_iarchive archive(stream);
+  std::uint32_t format_version;
+  std::uint64_t lanelet2_map_hash;
+  std::string projector;
+  double centerline_resolution;
+  archive >> format_version >> lanelet2_map_hash >> projector >> centerline_resolution;
+  if (
+    format_version != PrebuiltMapKey::format_version or
+    lanelet2_map_hash != key.lanelet2_map_hash or projector != key.projector or
+    centerline_resolution != key.centerline_resolution) {
+    return nullptr;
+  }
+  auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
+  lanelet::Id id_counter;
+  archive >> *lanelet_map_ptr >> id_counter;
+  /// @note Ids created later (e.g. for fine centerline points) must not collide with cached ones.
+  lanelet::utils::registerId(id_counter);
+  return lanelet_map_ptr;
+} catch (const std::exception &) {
+  return nullptr;
+}
+
+auto savePrebuiltMap(const PrebuiltMapKey & key, const lanelet::LaneletMap & lanelet_map) -> void
+{
+  const auto cache_path = key.cachePath();
+  boost::filesystem::path temporary_path;
+  try {
+    boost::filesystem::create_directories(cache_path.parent_path());
+    /// @note Write to a temporary file and rename it, so readers never see a partial file.
+    temporary_path = boost::filesystem::unique_path(cache_path.string() + ".%%%%-%%%%-%%%%");
+    {
+      std::ofstream file;
+      file.exceptions(std::ios::failbit | std::ios::badbit);
+      file.open(temporary_path.string(), std::ios::binary);
+      boost::archive::binary_oarchive archive(file);
+      const auto format_version = PrebuiltMapKey::format_version;
+      const auto id_counter = lanelet::utils::getId();
+      archive << format_version << key.lanelet2_map_hash << key.projector
+              << key.centerline_resolution << lanelet_map << id_counter;
+    }
+    boost::filesystem::rename(temporary_path, cache_path);
+  } catch (const std::exception & error) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("hdmap_utils"),
+      "Failed to save prebuilt map to " << cache_path << ", it is rebuilt next time: "
+                                        << error.what());
+    boost::system::error_code ignored;
+    boost::filesystem::remove(temporary_path, ignored);
+  }
+}
+}  // namespace hdmap_utils
@@ -0,0 +1,219 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <rclcpp/rclcpp.hpp>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/hdmap_utils/shared_map_image.hpp>
+
+namespace hdmap_utils
+{
+namespace
+{
+template <typename T>
+using Allocator = boost::interprocess::allocator<
+  T, boost::interprocess::managed_mapped_file::segment_manager>;
+
+struct Header
+{
+  std::uint32_t format_version;
+  std::uint64_t lanelet2_map_hash;
+  char projector[32];
+  double centerline_resolution;
+};
+
+struct Point
+{
+  double x, y, z;
+};
+
+/// @note Points of all polylines back to back, and the end of each polyline in the points.
+struct Polylines
+{
+  explicit Polylines(const Allocator<void> & allocator) : points(allocator), ends(allocator) {}
+
+  auto reserve(const std::size_t polyline_count, const std::size_t point_count) -> void
+  {
+    ends.reserve(polyline_count);
+    points.reserve(point_count);
+  }
+
+  auto push_back(const lanelet::ConstLineString3d & line_string) -> void
+  {
+    for (const auto & point : line_string) {
+      points.push_back({point.x(), point.y(), point.z()});
+    }
+    ends.push_back(points.size());
+  }
+
+  auto get(const std::size_t index) const -> std::vector<geometry_msgs::msg::Point>
+  {
+    std::vector<geometry_msgs::msg::Point> polyline;
+    for (auto i = index == 0 ? 0 : ends[index - 1]; i < ends[index]; ++i) {
+      geometry_msgs::msg::Point point;
+      point.x = points[i].x;
+      point.y = points[i].y;
+      point.z = points[i].z;
+      polyline.push_back(point);
+    }
+    return polyline;
+  }
+
+  boost::interprocess::vector<Point, Allocator<Point>> points;
+
+  boost::interprocess::vector<std::uint64_t, Allocator<std::uint64_t>> ends;
+};
+
+auto lineStringsName(const std::string & type) -> std::string
+{
+  return "line_strings/" + type;
+}
+}  // namespace
+
+auto SharedMapImage::imagePath(const boost::filesystem::path & prebuilt_map_path)
+  -> boost::filesystem::path
+{
+  return boost::filesystem::path(prebuilt_map_path).replace_extension(".image");
+}
+
+auto SharedMapImage::open(const PrebuiltMapKey & key, const boost::filesystem::path & image_path)
+  -> std::shared_ptr<const SharedMapImage>
+try {
+  if (not boost::filesystem::is_regular_file(image_path)) {
+    return nullptr;
+  }
+  std::shared_ptr<SharedMapImage> image(new SharedMapImage(image_path));
+  if (const auto header = image->file_.find_no_lock<Header>("header").first;
+      header and header->format_version == format_version and
+      header->lanelet2_map_hash == key.lanelet2_map_hash and
+      header->projector == key.projector and
+      header->centerline_resolution == key.centerline_resolution and
+      image->file_.find_no_lock<Polylines>("lanelet_bounds").first) {
+    return image;
+  } else {
+    return nullptr;
+  }
+} catch (const std::exception &) {
+  return nullptr;
+}
+
+auto SharedMapImage::save(const PrebuiltMapKey & key, const lanelet::LaneletMap & lanelet_map)
+  -> void
+{
+  const auto image_path = imagePath(key.cachePath());
+  boost::filesystem::path temporary_path;
+  try {
+    if (sizeof(Header::projector) <= key.projector.size()) {
+      throw std::length_error("projector name " + key.projector + " is too long");
+    }
+    std::size_t point_count = 0;
+    for (const auto & lanelet : lanelet_map.laneletLayer) {
+      point_count += lanelet.leftBound().size() + lanelet.rightBound().size();
+    }
+    std::map<std::string, std::vector<lanelet::ConstLineString3d>> line_strings;
+    for (const auto & line_string : lanelet_map.lineStringLayer) {
+      if (const std::string type = line_string.attributeOr(lanelet::AttributeName::Type, "");
+          not type.empty()) {
+        line_strings[type].push_back(line_string);
+        point_count += line_string.size();
+      }
+    }
+    /**
+     * @note Twice the size of the arrays leaves enough room for the bookkeeping of the allocator.
+     * The image is shrunk to fit after it is written.
+     */
+    const auto size =
+      (1 << 20) + 2 * point_count * sizeof(Point) +
+      2 * (2 * lanelet_map.laneletLayer.size() + lanelet_map.lineStringLayer.size()) *
+        sizeof(std::uint64_t);
+
+    boost::filesystem::create_directories(image_path.parent_path());
+    /// @note Write to a temporary file and rename it, so readers never see a partial image.
+    temporary_path = boost::filesystem::unique_path(image_path.string() + ".%%%%-%%%%-%%%%");
+    {
+      boost::interprocess::managed_mapped_file file(
+        boost::interprocess::create_only, temporary_path.c_str(), size);
+      const Allocator<void> allocator(file.get_segment_manager());
+      auto & lanelet_bounds = *file.construct<Polylines>("lanelet_bounds")(allocator);
+      lanelet_bounds.reserve(2 * lanelet_map.laneletLayer.size(), point_count);
+      for (const auto & lanelet : lanelet_map.laneletLayer) {
+        lanelet_bounds.push_back(lanelet.leftBound());
+        lanelet_bounds.push_back(lanelet.rightBound());
+      }
+      for (const auto & [type, line_strings_of_type] : line_strings) {
+        auto & polylines = *file.construct<Polylines>(lineStringsName(type).c_str())(allocator);
+        std::size_t point_count_of_type = 0;
+        for (const auto & line_string : line_strings_of_type) {
+          point_count_of_type += line_string.size();
+        }
+        polylines.reserve(line_strings_of_type.size(), point_count_of_type);
+        for (const auto & line_string : line_strings_of_type) {
+          polylines.push_back(line_string);
+        }
+      }
+      auto & header = *file.construct<Header>("header")();
+      header.format_version = format_version;
+      header.lanelet2_map_hash = key.lanelet2_map_hash;
+      std::strncpy(header.projector, key.projector.c_str(), sizeof(header.projector));
+      header.centerline_resolution = key.centerline_resolution;
+      file.flush();
+    }
+    boost::interprocess::managed_mapped_file::shrink_to_fit(temporary_path.c_str());
+    boost::filesystem::rename(temporary_path, image_path);
+  } catch (const std::exception & error) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("hdmap_utils"),
+      "Failed to save shared map image to " << image_path << ", it is rebuilt next time: "
+                                            << error.what());
+    boost::system::error_code ignored;
+    boost::filesystem::remove(temporary_path, ignored);
+  }
+}
+
+SharedMapImage::SharedMapImage(const boost::filesystem::path & image_path)
+: file_(boost::interprocess::open_read_only, image_path.c_str())
+{
+}
+
+auto SharedMapImage::getLaneletBounds() const -> std::vector<
+  std::pair<std::vector<geometry_msgs::msg::Point>, std::vector<geometry_msgs::msg::Point>>>
+{
+  /// @note The mapping is read-only, so named objects are looked up without the lock in it.
+  const auto & polylines = *file_.find_no_lock<Polylines>("lanelet_bounds").first;
+  std::vector<
+    std::pair<std::vector<geometry_msgs::msg::Point>, std::vector<geometry_msgs::msg::Point>>>
+    bounds;
+  for (std::size_t i = 0; i + 1 < polylines.ends.size(); i += 2) {
+    bounds.emplace_back(polylines.get(i), polylines.get(i + 1));
+  }
+  return bounds;
+}
+
+auto SharedMapImage::getLineStrings(const std::string & type) const
+  -> std::vector<std::vector<geometry_msgs::msg::Point>>
+{
+  std::vector<std::vector<geometry_msgs::msg::Point>> line_strings;
+  if (const auto polylines = file_.find_no_lock<Polylines>(lineStringsName(type).c_str()).first) {
+    for (std::size_t i = 0; i < polylines->ends.size(); ++i) {
+      line_strings.push_back(polylines->get(i));
+    }
+  }
+  return line_strings;
+}
+}  // namespace hdmap_utils
@@ -162,6 +162,16 @@ const simulation_api_schema::LidarConfiguration constructLidarConfiguration(
   return configuration;
 }
 
+const simulation_api_schema::LidarConfiguration constructLidarConfiguration(
+  const LidarType type, const std::string & entity, const std::string & architecture_type,
+  const double lidar_sensor_delay, const bool static_environment)
+{
+  auto configuration =
+    constructLidarConfiguration(type, entity, architecture_type, lidar_sensor_delay);
+  configuration.set_static_environment(static_environment);
+  return configuration;
+}
+
 }  // namespace helper
 }  // namespace traffic_simulator
 
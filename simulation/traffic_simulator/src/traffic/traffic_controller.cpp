@@ -37,11 +37,12 @@ namespace traffic
 {
 TrafficController::TrafficController(
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils,
-  const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+    get_entity_names_in_range_function,
   const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
   const std::function<void(std::string)> & despawn_function, bool auto_sink)
 : hdmap_utils_(hdmap_utils),
-  get_entity_names_function(get_entity_names_function),
+  get_entity_names_in_range_function(get_entity_names_in_range_function),
   get_entity_pose_function(get_entity_pose_function),
   despawn_function(despawn_function),
   auto_sink(auto_sink)
@@ -60,7 +61,7 @@ void TrafficController::autoSink()
       lanelet_pose.s = hdmap_utils_->getLaneletLength(lanelet_id);
       const auto pose = hdmap_utils_->toMapPose(lanelet_pose);
       addModule<traffic_simulator::traffic::TrafficSink>(
-        1, pose.pose.position, get_entity_names_function, get_entity_pose_function,
+        1, pose.pose.position, get_entity_names_in_range_function, get_entity_pose_function,
         despawn_function);
     }
   }
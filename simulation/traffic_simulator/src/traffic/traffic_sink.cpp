@@ -37,13 +37,14 @@ namespace traffic
 {
 TrafficSink::TrafficSink(
   double radius, const geometry_msgs::msg::Point & position,
-  const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+  const std::function<std::vector<std::string>(const geometry_msgs::msg::Point &, double)> &
+    get_entity_names_in_range_function,
   const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
   const std::function<void(std::string)> & despawn_function)
 : TrafficModuleBase(),
   radius(radius),
   position(position),
-  get_entity_names_function(get_entity_names_function),
+  get_entity_names_in_range_function(get_entity_names_in_range_function),
   get_entity_pose_function(get_entity_pose_function),
   despawn_function(despawn_function)
 {
@@ -52,8 +53,7 @@ TrafficSink::TrafficSink(
 void TrafficSink::execute(
   [[maybe_unused]] const double current_time, [[maybe_unused]] const double step_time)
 {
-  const auto names = get_entity_names_function();
-  for (const auto & name : names) {
+  for (const auto & name : get_entity_names_in_range_function(position, radius)) {
     const auto pose = get_entity_pose_function(name);
     if (math::geometry::getDistance(position, pose) <= radius) {
       despawn_function(name);
@@ -14,6 +14,7 @@
 
 #include <limits>
 #include <scenario_simulator_exception/exception.hpp>
+#include <set>
 #include <string>
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light.hpp>
@@ -198,28 +199,44 @@ TrafficLight::TrafficLight(const lanelet::Id lanelet_id, hdmap_utils::HdMapUtils
 {
 }
 
-auto TrafficLight::set(const std::string & states) -> void
+/// @note Split the states into the first bulb and the rest of them.
+static auto splitStates(const std::string & states) -> std::pair<std::string, std::string>
 {
-  auto split = [](auto && given) {
-    static const auto pattern = std::regex(R"(^(\w[\w\s]+)(,\s*)?(.*)$)");
-    if (std::smatch result; std::regex_match(given, result, pattern)) {
-      return std::make_pair(result.str(1), result.str(3));
-    } else {
-      throw common::SyntaxError("Invalid traffic light state ", std::quoted(given), " given.");
-    }
-  };
+  static const auto pattern = std::regex(R"(^(\w[\w\s]+)(,\s*)?(.*)$)");
+  if (std::smatch result; std::regex_match(states, result, pattern)) {
+    return std::make_pair(result.str(1), result.str(3));
+  } else {
+    throw common::SyntaxError("Invalid traffic light state ", std::quoted(states), " given.");
+  }
+}
 
+auto TrafficLight::set(const std::string & states) -> void
+{
   if (not states.empty()) {
-    auto && [head, tail] = split(states);
+    auto && [head, tail] = splitStates(states);
     emplace(head);
     set(tail);
   }
 }
 
+auto TrafficLight::assign(const std::string & states) -> void
+{
+  std::set<Bulb> bulbs;
+  for (auto rest = states; not rest.empty();) {
+    auto [head, tail] = splitStates(rest);
+    bulbs.emplace(head);
+    rest = std::move(tail);
+  }
+  if (bulbs != bulbs_) {
+    bulbs_ = std::move(bulbs);
+    ++version_;
+  }
+}
+
 auto operator<<(std::ostream & os, const TrafficLight & traffic_light) -> std::ostream &
 {
   std::string separator = "";
-  for (auto && bulb : traffic_light.bulbs) {
+  for (auto && bulb : traffic_light.bulbs_) {
     os << separator << bulb;
     separator = ", ";
   }
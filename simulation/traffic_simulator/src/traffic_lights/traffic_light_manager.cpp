@@ -27,18 +27,25 @@ TrafficLightManager::TrafficLightManager(const std::shared_ptr<hdmap_utils::HdMa
 {
 }
 
-auto TrafficLightManager::hasAnyLightChanged() -> bool
+auto TrafficLightManager::getVersion() const -> std::size_t
 {
-  return true;
-  // return std::any_of(
-  //   std::begin(getTrafficLights()), std::end(getTrafficLights()), [](auto && id_and_traffic_light) {
-  //     return id_and_traffic_light.second.colorChanged() or
-  //            id_and_traffic_light.second.arrowChanged();
-  //   });
+  std::lock_guard<std::mutex> lock(traffic_lights_mutex_);
+  /// @note Each traffic light adds 1 to its own version, so creating a traffic light is a change.
+  std::size_t version = 0;
+  for (const auto & [id, traffic_light] : traffic_lights_) {
+    version += traffic_light.version() + 1;
+  }
+  return version;
+}
+
+auto TrafficLightManager::hasAnyLightChanged(const std::size_t since_version) const -> bool
+{
+  return getVersion() != since_version;
 }
 
 auto TrafficLightManager::getTrafficLight(const lanelet::Id traffic_light_id) -> TrafficLight &
 {
+  std::lock_guard<std::mutex> lock(traffic_lights_mutex_);
   if (auto iter = traffic_lights_.find(traffic_light_id); iter != std::end(traffic_lights_)) {
     return iter->second;
   } else {
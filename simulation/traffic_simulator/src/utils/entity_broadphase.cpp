@@ -0,0 +1,126 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/bounding_box.hpp>
+#include <geometry/transform.hpp>
+#include <numeric>
+#include <traffic_simulator/utils/entity_broadphase.hpp>
+
+namespace traffic_simulator
+{
+BoundingBox2D::BoundingBox2D(
+  const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox)
+: min_x(pose.position.x), min_y(pose.position.y), max_x(pose.position.x), max_y(pose.position.y)
+{
+  for (const auto & point :
+       math::geometry::transformPoints(pose, math::geometry::getPointsFromBbox(bbox))) {
+    min_x = std::min(min_x, point.x);
+    min_y = std::min(min_y, point.y);
+    max_x = std::max(max_x, point.x);
+    max_y = std::max(max_y, point.y);
+  }
+}
+
+BoundingBox2D::BoundingBox2D(const geometry_msgs::msg::Point & center, const double radius)
+: min_x(center.x - radius),
+  min_y(center.y - radius),
+  max_x(center.x + radius),
+  max_y(center.y + radius)
+{
+}
+
+auto BoundingBox2D::intersects(const BoundingBox2D & other) const noexcept -> bool
+{
+  return min_x <= other.max_x and other.min_x <= max_x and min_y <= other.max_y and
+         other.min_y <= max_y;
+}
+
+EntityBroadphase::EntityBroadphase(const Statuses & statuses, const double cell_size)
+: cell_size_(cell_size)
+{
+  names_.reserve(statuses.size());
+  bounding_boxes_.reserve(statuses.size());
+  for (const auto & [name, status] : statuses) {
+    const auto index = names_.size();
+    names_.push_back(name);
+    forEachCell(
+      bounding_boxes_.emplace_back(status.getMapPose(), status.getBoundingBox()),
+      [&](const auto key) { cells_[key].push_back(index); });
+    if (status.laneMatchingSucceed()) {
+      lanelets_[status.getLaneletPose().lanelet_id].push_back(index);
+    }
+  }
+}
+
+auto EntityBroadphase::getEntityNamesInRange(
+  const geometry_msgs::msg::Point & center, const double radius) const -> std::vector<std::string>
+{
+  const auto range = BoundingBox2D(center, radius);
+  std::vector<std::size_t> indices;
+  /// @note If the range covers more cells than entities, checking every entity is cheaper.
+  if (
+    (static_cast<double>(getCellIndex(range.max_x)) - getCellIndex(range.min_x) + 1) *
+      (static_cast<double>(getCellIndex(range.max_y)) - getCellIndex(range.min_y) + 1) >
+    static_cast<double>(names_.size())) {
+    indices.resize(names_.size());
+    std::iota(indices.begin(), indices.end(), 0);
+  } else {
+    forEachCell(range, [&](const auto key) {
+      if (const auto cell = cells_.find(key); cell != cells_.end()) {
+        indices.insert(indices.end(), cell->second.begin(), cell->second.end());
+      }
+    });
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  }
+  std::vector<std::string> names;
+  for (const auto index : indices) {
+    if (bounding_boxes_[index].intersects(range)) {
+      names.push_back(names_[index]);
+    }
+  }
+  return names;
+}
+
+auto EntityBroadphase::getEntityNamesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<std::string>
+{
+  std::vector<std::size_t> indices;
+  for (const auto & lanelet_id : lanelet_ids) {
+    if (const auto lanelet = lanelets_.find(lanelet_id); lanelet != lanelets_.end()) {
+      indices.insert(indices.end(), lanelet->second.begin(), lanelet->second.end());
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  std::vector<std::string> names;
+  for (const auto index : indices) {
+    names.push_back(names_[index]);
+  }
+  return names;
+}
+
+auto EntityBroadphase::getCellIndex(const double coordinate) const -> std::int32_t
+{
+  return static_cast<std::int32_t>(std::floor(coordinate / cell_size_));
+}
+
+auto EntityBroadphase::getCellKey(const std::int32_t x, const std::int32_t y) -> std::uint64_t
+{
+  return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32 |
+         static_cast<std::uint32_t>(y);
+}
+}  // namespace traffic_simulator
@@ -0,0 +1,99 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <traffic_simulator/utils/worker_pool.hpp>
+
+namespace traffic_simulator
+{
+WorkerPool::WorkerPool(const std::size_t thread_count)
+{
+  for (std::size_t i = 1; i < thread_count; ++i) {
+    threads_.emplace_back([this]() { work(); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  job_started_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+auto WorkerPool::run(const std::size_t size, const std::function<void(std::size_t)> & function)
+  -> void
+{
+  if (size == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    function_ = &function;
+    size_ = size;
+    next_index_ = 0;
+    exceptions_.assign(size, nullptr);
+    busy_thread_count_ = threads_.size();
+    ++job_count_;
+  }
+  job_started_.notify_all();
+  runJob();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_finished_.wait(lock, [this]() { return busy_thread_count_ == 0; });
+    function_ = nullptr;
+  }
+  for (const auto & exception : exceptions_) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+auto WorkerPool::runJob() -> void
+{
+  for (auto index = next_index_++; index < size_; index = next_index_++) {
+    try {
+      (*function_)(index);
+    } catch (...) {
+      exceptions_[index] = std::current_exception();
+    }
+  }
+}
+
+auto WorkerPool::work() -> void
+{
+  std::size_t job_count = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_started_.wait(lock, [&]() { return stopped_ or job_count_ != job_count; });
+      if (stopped_) {
+        return;
+      }
+      job_count = job_count_;
+    }
+    runJob();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--busy_thread_count_ == 0) {
+        job_finished_.notify_one();
+      }
+    }
+  }
+}
+}  // namespace traffic_simulator
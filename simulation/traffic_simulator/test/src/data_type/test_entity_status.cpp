@@ -0,0 +1,109 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <vector>
+
+auto makeSnapshot() -> std::shared_ptr<traffic_simulator::EntityStatusSnapshot>
+{
+  auto snapshot = std::make_shared<traffic_simulator::EntityStatusSnapshot>();
+  snapshot->version = 3;
+  for (const auto & name : {"ego", "npc1", "npc2"}) {
+    traffic_simulator::EntityStatus status;
+    status.name = name;
+    status.lanelet_pose_valid = false;
+    snapshot->statuses.emplace(name, traffic_simulator::CanonicalizedEntityStatus(status, nullptr));
+  }
+  return snapshot;
+}
+
+TEST(OtherEntityStatus, ExcludeSelf)
+{
+  const traffic_simulator::OtherEntityStatus other_status(makeSnapshot(), "ego");
+  EXPECT_EQ(other_status.size(), 2U);
+  EXPECT_EQ(other_status.version(), 3U);
+  EXPECT_EQ(other_status.find("ego"), other_status.end());
+  EXPECT_EQ(other_status.count("ego"), 0U);
+  EXPECT_THROW(other_status.at("ego"), std::out_of_range);
+  EXPECT_EQ(other_status.at("npc1").getName(), "npc1");
+  std::size_t count = 0;
+  for (const auto & [name, status] : other_status) {
+    EXPECT_NE(name, "ego");
+    EXPECT_EQ(status.getName(), name);
+    ++count;
+  }
+  EXPECT_EQ(count, 2U);
+}
+
+TEST(OtherEntityStatus, ShareSnapshot)
+{
+  const auto snapshot = makeSnapshot();
+  const traffic_simulator::OtherEntityStatus other_status(snapshot, "npc1");
+  const auto copied = other_status;
+  EXPECT_EQ(&other_status.at("ego"), &snapshot->statuses.at("ego"));
+  EXPECT_EQ(&copied.at("ego"), &snapshot->statuses.at("ego"));
+}
+
+/**
+ * @note Iterators are supposed to keep excluding the entity after the view they are taken from is
+ * moved and destroyed, as long as the snapshot is shared by another view.
+ */
+TEST(OtherEntityStatus, IterateAfterMove)
+{
+  auto other_status = std::make_unique<traffic_simulator::OtherEntityStatus>(makeSnapshot(), "ego");
+  auto iter = other_status->begin();
+  const auto end = other_status->end();
+  const auto moved = std::move(*other_status);
+  other_status.reset();
+  std::size_t count = 0;
+  for (; iter != end; ++iter) {
+    EXPECT_NE(iter->first, "ego");
+    ++count;
+  }
+  EXPECT_EQ(count, 2U);
+  EXPECT_EQ(moved.size(), 2U);
+  EXPECT_EQ(moved.find("ego"), moved.end());
+}
+
+TEST(OtherEntityStatus, Broadphase)
+{
+  const traffic_simulator::OtherEntityStatus other_status(makeSnapshot(), "ego");
+  auto names = other_status.getEntityNamesInRange(geometry_msgs::msg::Point(), 1.0);
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ(names, std::vector<std::string>({"npc1", "npc2"}));
+  EXPECT_TRUE(other_status.getEntityNamesOnLanelets({34513}).empty());
+  EXPECT_TRUE(traffic_simulator::OtherEntityStatus()
+                .getEntityNamesInRange(geometry_msgs::msg::Point(), 1.0)
+                .empty());
+}
+
+TEST(OtherEntityStatus, Empty)
+{
+  const traffic_simulator::OtherEntityStatus other_status;
+  EXPECT_TRUE(other_status.empty());
+  EXPECT_EQ(other_status.begin(), other_status.end());
+  EXPECT_EQ(other_status.version(), 0U);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
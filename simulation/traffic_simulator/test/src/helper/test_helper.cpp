@@ -91,6 +91,18 @@ TEST(HELPER, LIDAR_SENSOR_CONFIGURATION)
     traffic_simulator::helper::LidarType::VLP16, "ego", "test"));
   EXPECT_NO_THROW(traffic_simulator::helper::constructLidarConfiguration(
     traffic_simulator::helper::LidarType::VLP32, "ego", "test"));
+  EXPECT_FALSE(traffic_simulator::helper::constructLidarConfiguration(
+                 traffic_simulator::helper::LidarType::VLP16, "ego", "test")
+                 .static_environment());
+  const auto static_environment_configuration =
+    traffic_simulator::helper::constructLidarConfiguration(
+      traffic_simulator::helper::LidarType::VLP16, "ego", "test", 0, true);
+  EXPECT_TRUE(static_environment_configuration.static_environment());
+  EXPECT_DOUBLE_EQ(
+    static_environment_configuration.horizontal_resolution(),
+    traffic_simulator::helper::constructLidarConfiguration(
+      traffic_simulator::helper::LidarType::VLP16, "ego", "test")
+      .horizontal_resolution());
 }
 
 int main(int argc, char ** argv)
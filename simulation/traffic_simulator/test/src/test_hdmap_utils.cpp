@@ -14,10 +14,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <optional>
+#include <scenario_simulator_exception/exception.hpp>
 #include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/prebuilt_map.hpp>
+#include <traffic_simulator/hdmap_utils/shared_map_image.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <traffic_simulator/utils/worker_pool.hpp>
+#include <utility>
+#include <vector>
 
 TEST(HdMapUtils, Construct)
 {
@@ -313,6 +321,450 @@ TEST(HdMapUtils, CanonicalizeAll)
   EXPECT_EQ(canonicalized_lanelet_poses[0].s, non_canonicalized_lanelet_s);
 }
 
+/**
+ * @note Testcase for the prebuilt map cache.
+ * Constructing HdMapUtils stores the prebuilt map, and a second HdMapUtils constructed from the
+ * cache is supposed to have the same lanelets and centerlines as the first one.
+ */
+TEST(HdMapUtils, PrebuiltMap)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+
+  const auto prebuilt_map =
+    hdmap_utils::loadPrebuiltMap(hdmap_utils::PrebuiltMapKey(path, "MGRS", 2.0));
+  ASSERT_TRUE(prebuilt_map);
+  EXPECT_EQ(prebuilt_map->laneletLayer.size(), hdmap_utils.getLaneletIds().size());
+  EXPECT_FALSE(hdmap_utils::loadPrebuiltMap(hdmap_utils::PrebuiltMapKey(path, "MGRS", 1.0)));
+  EXPECT_FALSE(hdmap_utils::loadPrebuiltMap(hdmap_utils::PrebuiltMapKey(path, "UTM", 2.0)));
+  EXPECT_NE(
+    hdmap_utils::PrebuiltMapKey(path, "MGRS", 2.0).cachePath(),
+    hdmap_utils::PrebuiltMapKey(path, "MGRS", 1.0).cachePath());
+  EXPECT_NE(
+    hdmap_utils::PrebuiltMapKey(path, "MGRS", 2.0).cachePath(),
+    hdmap_utils::PrebuiltMapKey(path, "UTM", 2.0).cachePath());
+
+  hdmap_utils::HdMapUtils cached_hdmap_utils(path, origin);
+  EXPECT_EQ(cached_hdmap_utils.getLaneletIds(), hdmap_utils.getLaneletIds());
+  EXPECT_EQ(cached_hdmap_utils.getCenterPoints(34981), hdmap_utils.getCenterPoints(34981));
+  EXPECT_DOUBLE_EQ(cached_hdmap_utils.getLaneletLength(34981), hdmap_utils.getLaneletLength(34981));
+}
+
+/**
+ * @note Another process attaches to the prebuilt map by its path, and falls back to loading the
+ * lanelet map when the path does not point to a prebuilt map of the same lanelet map.
+ */
+TEST(HdMapUtils, AttachPrebuiltMap)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  ASSERT_TRUE(boost::filesystem::exists(hdmap_utils.getPrebuiltMapPath()));
+
+  hdmap_utils::HdMapUtils attached_hdmap_utils(path, hdmap_utils.getPrebuiltMapPath(), origin);
+  EXPECT_EQ(attached_hdmap_utils.getPrebuiltMapPath(), hdmap_utils.getPrebuiltMapPath());
+  EXPECT_EQ(attached_hdmap_utils.getLaneletIds(), hdmap_utils.getLaneletIds());
+  EXPECT_EQ(attached_hdmap_utils.getCenterPoints(34981), hdmap_utils.getCenterPoints(34981));
+
+  hdmap_utils::HdMapUtils fallback_hdmap_utils(path, path + ".nonexistent", origin);
+  EXPECT_EQ(fallback_hdmap_utils.getPrebuiltMapPath(), hdmap_utils.getPrebuiltMapPath());
+  EXPECT_EQ(fallback_hdmap_utils.getLaneletIds(), hdmap_utils.getLaneletIds());
+
+  const auto other_path = ament_index_cpp::get_package_share_directory("traffic_simulator") +
+                          "/map/with_road_shoulder/lanelet2_map.osm";
+  hdmap_utils::HdMapUtils mismatched_hdmap_utils(
+    other_path, hdmap_utils.getPrebuiltMapPath(), origin);
+  EXPECT_EQ(
+    mismatched_hdmap_utils.getPrebuiltMapPath(),
+    hdmap_utils::HdMapUtils::prebuiltMapKey(other_path).cachePath());
+  EXPECT_NE(mismatched_hdmap_utils.getLaneletIds(), hdmap_utils.getLaneletIds());
+}
+
+/**
+ * @note The shared map image is supposed to hold the same geometry as the map it is built from, and
+ * not to be opened with a different key.
+ */
+TEST(HdMapUtils, SharedMapImage)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto image_path =
+    hdmap_utils::SharedMapImage::imagePath(hdmap_utils.getPrebuiltMapPath());
+
+  const auto image =
+    hdmap_utils::SharedMapImage::open(hdmap_utils::HdMapUtils::prebuiltMapKey(path), image_path);
+  ASSERT_TRUE(image);
+  const auto lanelet_ids = hdmap_utils.getLaneletIds();
+  const auto lanelet_bounds = image->getLaneletBounds();
+  ASSERT_EQ(lanelet_bounds.size(), lanelet_ids.size());
+  for (std::size_t i = 0; i < lanelet_ids.size(); ++i) {
+    EXPECT_EQ(lanelet_bounds[i].first, hdmap_utils.getLeftBound(lanelet_ids[i]));
+    EXPECT_EQ(lanelet_bounds[i].second, hdmap_utils.getRightBound(lanelet_ids[i]));
+  }
+  EXPECT_FALSE(image->getLineStrings("line_thin").empty());
+  EXPECT_EQ(image->getLineStrings("line_thin"), hdmap_utils.getLineStrings({"line_thin"}));
+  EXPECT_TRUE(image->getLineStrings("nonexistent").empty());
+
+  EXPECT_FALSE(hdmap_utils::SharedMapImage::open(
+    hdmap_utils::PrebuiltMapKey(path, "MGRS", 1.0), image_path));
+  EXPECT_FALSE(hdmap_utils::SharedMapImage::open(
+    hdmap_utils::HdMapUtils::prebuiltMapKey(path), image_path.string() + ".nonexistent"));
+}
+
+/**
+ * @note Matching with the lanelet spatial index is supposed to give the same s values as solving
+ * for the s value on every curve of the centerline spline.
+ */
+TEST(HdMapUtils, ToLaneletPoseWithSpatialIndex)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  for (const auto lanelet_id : {34513, 34564, 34981, 120659}) {
+    const auto spline = hdmap_utils.getCenterPointsSpline(lanelet_id);
+    for (double s = 0.0; s < hdmap_utils.getLaneletLength(lanelet_id); s += 1.0) {
+      const auto pose = hdmap_utils.toMapPose(
+        traffic_simulator::helper::constructLaneletPose(lanelet_id, s, 0.5)).pose;
+      const auto expected = spline->getSValue(pose, 1.0);
+      const auto lanelet_pose = hdmap_utils.toLaneletPose(pose, lanelet_id, 1.0);
+      ASSERT_EQ(expected.has_value(), lanelet_pose.has_value());
+      if (lanelet_pose) {
+        EXPECT_DOUBLE_EQ(lanelet_pose->s, expected.value());
+      }
+    }
+  }
+  const auto nearby_lanelet_ids = hdmap_utils.getNearbyLaneletIds(
+    hdmap_utils.toMapPose(traffic_simulator::helper::constructLaneletPose(34513, 1, 0))
+      .pose.position,
+    0.1);
+  EXPECT_NE(
+    std::find(nearby_lanelet_ids.begin(), nearby_lanelet_ids.end(), 34513),
+    nearby_lanelet_ids.end());
+}
+
+/**
+ * @note Matching poses in a batch is supposed to give the same results as matching them one by one,
+ * regardless of whether they are matched on a worker pool.
+ */
+TEST(HdMapUtils, ToLaneletPosesInBatch)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto lanelet_id : {34513, 34564, 34981, 120659}) {
+    for (double s = 0.0; s < hdmap_utils.getLaneletLength(lanelet_id); s += 2.5) {
+      poses.push_back(
+        hdmap_utils.toMapPose(traffic_simulator::helper::constructLaneletPose(lanelet_id, s, 0.3))
+          .pose);
+    }
+  }
+  geometry_msgs::msg::Pose pose_outside_of_lanelets;
+  pose_outside_of_lanelets.position.x = -1000.0;
+  poses.push_back(pose_outside_of_lanelets);
+
+  traffic_simulator::WorkerPool worker_pool(4);
+  for (const auto pool : {static_cast<traffic_simulator::WorkerPool *>(nullptr), &worker_pool}) {
+    const auto lanelet_poses = hdmap_utils.toLaneletPoses(poses, false, 1.0, pool);
+    ASSERT_EQ(lanelet_poses.size(), poses.size());
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      const auto expected = hdmap_utils.toLaneletPose(poses[i], false, 1.0);
+      ASSERT_EQ(lanelet_poses[i].has_value(), expected.has_value());
+      if (expected) {
+        EXPECT_EQ(lanelet_poses[i]->lanelet_id, expected->lanelet_id);
+        EXPECT_DOUBLE_EQ(lanelet_poses[i]->s, expected->s);
+        EXPECT_DOUBLE_EQ(lanelet_poses[i]->offset, expected->offset);
+      }
+    }
+    EXPECT_FALSE(lanelet_poses.back());
+  }
+  EXPECT_TRUE(
+    hdmap_utils.toLaneletPoses(std::vector<geometry_msgs::msg::Pose>(), false, 1.0, &worker_pool)
+      .empty());
+}
+
+/**
+ * @note EntityManager::setEntityStatuses matches entities in batch, and
+ * EntityBase::fillLaneletPose matches them one by one. Both must give the same lanelet pose for the
+ * same route and bounding box.
+ */
+TEST(HdMapUtils, ToLaneletPosesWithRouteInBatch)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto lanelet_ids = hdmap_utils.getLaneletIds();
+  const auto branch = std::find_if(lanelet_ids.begin(), lanelet_ids.end(), [&](const auto id) {
+    return hdmap_utils.getNextLaneletIds(id).size() >= 2;
+  });
+  ASSERT_NE(branch, lanelet_ids.end());
+  const auto next_lanelet_ids = hdmap_utils.getNextLaneletIds(*branch);
+  const auto lanelet_id = next_lanelet_ids[0];
+  const auto pose =
+    hdmap_utils.toMapPose(traffic_simulator::helper::constructLaneletPose(lanelet_id, 0.5, 0)).pose;
+  traffic_simulator_msgs::msg::BoundingBox small_bbox;
+  small_bbox.dimensions.x = 1.0;
+  small_bbox.dimensions.y = 1.0;
+  traffic_simulator_msgs::msg::BoundingBox vehicle_bbox;
+  vehicle_bbox.center.x = 1.5;
+  vehicle_bbox.dimensions.x = 4.5;
+  vehicle_bbox.dimensions.y = 2.0;
+
+  std::vector<geometry_msgs::msg::Pose> poses;
+  std::vector<traffic_simulator_msgs::msg::BoundingBox> bboxes;
+  std::vector<lanelet::Ids> route_lanelets;
+  for (const auto & route : std::vector<lanelet::Ids>{
+         {}, {next_lanelet_ids[0]}, {next_lanelet_ids[1]}, {*branch, next_lanelet_ids[1]}}) {
+    for (const auto & bbox : {small_bbox, vehicle_bbox}) {
+      poses.push_back(pose);
+      bboxes.push_back(bbox);
+      route_lanelets.push_back(route);
+    }
+  }
+
+  traffic_simulator::WorkerPool worker_pool(4);
+  for (const auto pool : {static_cast<traffic_simulator::WorkerPool *>(nullptr), &worker_pool}) {
+    const auto lanelet_poses =
+      hdmap_utils.toLaneletPoses(poses, bboxes, route_lanelets, false, 1.0, pool);
+    ASSERT_EQ(lanelet_poses.size(), poses.size());
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      const auto expected =
+        hdmap_utils.toLaneletPose(poses[i], bboxes[i], route_lanelets[i], false, 1.0);
+      ASSERT_EQ(lanelet_poses[i].has_value(), expected.has_value());
+      if (expected) {
+        EXPECT_EQ(lanelet_poses[i]->lanelet_id, expected->lanelet_id);
+        EXPECT_DOUBLE_EQ(lanelet_poses[i]->s, expected->s);
+        EXPECT_DOUBLE_EQ(lanelet_poses[i]->offset, expected->offset);
+      }
+    }
+  }
+  {
+    const auto lanelet_pose =
+      hdmap_utils.toLaneletPose(pose, vehicle_bbox, {next_lanelet_ids[0]}, false, 1.0);
+    ASSERT_TRUE(lanelet_pose);
+    EXPECT_EQ(lanelet_pose->lanelet_id, next_lanelet_ids[0]);
+  }
+  EXPECT_THROW(
+    hdmap_utils.toLaneletPoses(poses, bboxes, std::vector<lanelet::Ids>(), false, 1.0),
+    common::SimulationError);
+}
+
+/**
+ * @note Conflicting lanelets are looked up from the table built on construction, so querying
+ * several lanelets at once is supposed to give the concatenation of querying them one by one.
+ */
+TEST(HdMapUtils, ConflictingLaneletIds)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  lanelet::Ids conflicting_lane_ids;
+  lanelet::Ids conflicting_crosswalk_ids;
+  for (const auto lanelet_id : hdmap_utils.getLaneletIds()) {
+    for (const auto id : hdmap_utils.getConflictingLaneIds({lanelet_id})) {
+      conflicting_lane_ids.push_back(id);
+    }
+    for (const auto id : hdmap_utils.getConflictingCrosswalkIds({lanelet_id})) {
+      conflicting_crosswalk_ids.push_back(id);
+    }
+  }
+  EXPECT_FALSE(conflicting_lane_ids.empty());
+  EXPECT_FALSE(conflicting_crosswalk_ids.empty());
+  EXPECT_EQ(hdmap_utils.getConflictingLaneIds(hdmap_utils.getLaneletIds()), conflicting_lane_ids);
+  EXPECT_EQ(
+    hdmap_utils.getConflictingCrosswalkIds(hdmap_utils.getLaneletIds()), conflicting_crosswalk_ids);
+}
+
+TEST(HdMapUtils, TrafficLightRegulatoryElementIDsFromTrafficLight)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  EXPECT_EQ(
+    hdmap_utils.getTrafficLightRegulatoryElementIDsFromTrafficLight(34802), lanelet::Ids({34806}));
+}
+
+TEST(HdMapUtils, LineStrings)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto stop_lines = hdmap_utils.getLineStrings({"stop_line"});
+  EXPECT_EQ(stop_lines.size(), 2U);
+  for (const auto & stop_line : stop_lines) {
+    EXPECT_GE(stop_line.size(), 2U);
+  }
+  EXPECT_TRUE(hdmap_utils.getLineStrings({"fence", "wall"}).empty());
+}
+
+/**
+ * @brief Position of the origin of the lanelet `to` in the coordinate of the lanelet `from`,
+ *        computed without the transition cache of HdMapUtils.
+ */
+auto getLaneChangeDisplacement(
+  const hdmap_utils::HdMapUtils & hdmap_utils, const lanelet::Id from, const lanelet::Id to)
+  -> std::optional<std::pair<double, double>>
+{
+  traffic_simulator_msgs::msg::LaneletPose next_lanelet_pose;
+  next_lanelet_pose.lanelet_id = to;
+  if (
+    const auto next_lanelet_origin_from_current_lanelet =
+      hdmap_utils.toLaneletPose(hdmap_utils.toMapPose(next_lanelet_pose).pose, from, 10.0)) {
+    return std::make_pair(
+      next_lanelet_origin_from_current_lanelet->s,
+      next_lanelet_origin_from_current_lanelet->offset);
+  }
+  traffic_simulator_msgs::msg::LaneletPose current_lanelet_pose;
+  current_lanelet_pose.lanelet_id = from;
+  if (
+    const auto current_lanelet_origin_from_next_lanelet =
+      hdmap_utils.toLaneletPose(hdmap_utils.toMapPose(current_lanelet_pose).pose, to, 10.0)) {
+    return std::make_pair(
+      -current_lanelet_origin_from_next_lanelet->s,
+      -current_lanelet_origin_from_next_lanelet->offset);
+  }
+  return std::nullopt;
+}
+
+/**
+ * @note Lane change transitions are memoized on the first query, so distances are supposed to be
+ * the same as those computed from the displacements of every lane change on the route, and to stay
+ * the same when the same pair of lanelet poses is queried again.
+ */
+TEST(HdMapUtils, DistanceWithLaneChange)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  traffic_simulator_msgs::msg::EntityType type;
+  type.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  std::size_t lane_change_count = 0;
+  for (const auto lanelet_id : hdmap_utils.getLaneletIds()) {
+    for (const auto left_lanelet_id : hdmap_utils.getLeftLaneletIds(lanelet_id, type, false)) {
+      traffic_simulator_msgs::msg::LaneletPose from;
+      from.lanelet_id = lanelet_id;
+      from.s = 0.0;
+      traffic_simulator_msgs::msg::LaneletPose to;
+      to.lanelet_id = left_lanelet_id;
+      to.s = 0.0;
+      const auto longitudinal_distance = hdmap_utils.getLongitudinalDistance(from, to, true);
+      const auto lateral_distance = hdmap_utils.getLateralDistance(from, to, true);
+
+      EXPECT_EQ(hdmap_utils.getLongitudinalDistance(from, to, true), longitudinal_distance);
+      EXPECT_EQ(hdmap_utils.getLateralDistance(from, to, true), lateral_distance);
+
+      /// @note Only routes consisting of a single lane change are compared with the displacement.
+      if (
+        hdmap_utils.getRoute(from.lanelet_id, to.lanelet_id, true) !=
+        lanelet::Ids({from.lanelet_id, to.lanelet_id})) {
+        continue;
+      }
+      if (const auto displacement =
+            getLaneChangeDisplacement(hdmap_utils, from.lanelet_id, to.lanelet_id)) {
+        ASSERT_TRUE(longitudinal_distance);
+        ASSERT_TRUE(lateral_distance);
+        /// @note "first lanelet before the lane change" case, in which the lane change ends.
+        EXPECT_DOUBLE_EQ(longitudinal_distance.value(), displacement->first + to.s - from.s);
+        EXPECT_DOUBLE_EQ(lateral_distance.value(), to.offset - from.offset + displacement->second);
+        ++lane_change_count;
+      } else {
+        EXPECT_FALSE(longitudinal_distance);
+        EXPECT_FALSE(lateral_distance);
+      }
+    }
+  }
+  EXPECT_GT(lane_change_count, 0U);
+}
+
+/**
+ * @note A cache with a single route evicts it every time another route is asked for, so it is
+ * supposed to give the same routes as the default one by finding them again.
+ */
+TEST(HdMapUtils, RouteCacheCapacity)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  hdmap_utils::HdMapUtils hdmap_utils_with_small_cache(path, origin, 1);
+  for (int i = 0; i < 2; ++i) {
+    for (const auto & [from, to] : {std::make_pair(34681, 34513), std::make_pair(34600, 34621)}) {
+      const auto route = hdmap_utils_with_small_cache.getRoute(from, to);
+      EXPECT_FALSE(route.empty());
+      EXPECT_EQ(route, hdmap_utils.getRoute(from, to));
+    }
+  }
+}
+
+/// @note Hashes keys to themselves, so that the test can choose the shard of each key.
+struct IdentityHash
+{
+  auto operator()(const lanelet::Id id) const -> std::size_t
+  {
+    return static_cast<std::size_t>(id);
+  }
+};
+
+TEST(LruCache, EvictLeastRecentlyUsed)
+{
+  hdmap_utils::LruCache<lanelet::Id, double, IdentityHash> cache(16);
+  for (lanelet::Id id = 0; id < 16; ++id) {
+    cache.insert(id * 16, static_cast<double>(id));
+  }
+  /// @note All the keys fall into the same shard, whose capacity is 1.
+  EXPECT_FALSE(cache.find(0));
+  EXPECT_DOUBLE_EQ(cache.find(15 * 16).value(), 15.0);
+  cache.insert(1, 1.0);
+  cache.insert(1, 2.0);
+  EXPECT_DOUBLE_EQ(cache.find(1).value(), 2.0);
+}
+
+TEST(LruCache, Unbounded)
+{
+  hdmap_utils::LaneletLengthCache cache;
+  for (lanelet::Id id = 0; id < 1000; ++id) {
+    cache.appendData(id, static_cast<double>(id));
+  }
+  for (lanelet::Id id = 0; id < 1000; ++id) {
+    EXPECT_DOUBLE_EQ(cache.getLength(id).value(), static_cast<double>(id));
+  }
+  EXPECT_FALSE(cache.getLength(1000));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -365,6 +365,28 @@ TEST(TrafficLight, TrafficLight)
     EXPECT_TRUE(traffic_light.contains(Color::red, Status::flashing, Shape::circle));
     EXPECT_TRUE(traffic_light.contains(Color::green, Status::solid_on, Shape::right));
   }
+
+  {
+    auto traffic_light = TrafficLight(34802, map_manager);
+
+    traffic_light.assign("red flashing circle, green solidOn right");
+    const auto version = traffic_light.version();
+
+    EXPECT_TRUE(traffic_light.contains(Color::red, Status::flashing, Shape::circle));
+    EXPECT_TRUE(traffic_light.contains(Color::green, Status::solid_on, Shape::right));
+
+    traffic_light.assign("green solidOn right, red flashing circle");
+    EXPECT_EQ(traffic_light.version(), version);
+
+    traffic_light.assign("yellow solidOn circle");
+    EXPECT_EQ(traffic_light.version(), version + 1);
+    EXPECT_TRUE(traffic_light.contains(Color::yellow, Status::solid_on, Shape::circle));
+    EXPECT_FALSE(traffic_light.contains(Color::red, Status::flashing, Shape::circle));
+
+    traffic_light.assign("");
+    EXPECT_EQ(traffic_light.version(), version + 2);
+    EXPECT_TRUE(traffic_light.empty());
+  }
 }
 
 int main(int argc, char ** argv)
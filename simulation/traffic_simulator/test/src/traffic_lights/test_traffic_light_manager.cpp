@@ -90,6 +90,37 @@ TEST(TrafficLightManager, setArrow)
   }
 }
 
+TEST(TrafficLightManager, getVersion)
+{
+  const auto node = std::make_shared<rclcpp::Node>("getVersion");
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const auto hdmap_utils_ptr = std::make_shared<hdmap_utils::HdMapUtils>(path, origin);
+  traffic_simulator::TrafficLightManager manager(hdmap_utils_ptr);
+  using Color = traffic_simulator::TrafficLight::Color;
+  auto version = manager.getVersion();
+  manager.getTrafficLight(34836);
+  EXPECT_TRUE(manager.hasAnyLightChanged(version));
+  version = manager.getVersion();
+  manager.getTrafficLight(34836).emplace(Color::green);
+  EXPECT_TRUE(manager.hasAnyLightChanged(version));
+  version = manager.getVersion();
+  manager.getTrafficLight(34836).emplace(Color::green);
+  manager.getTrafficLight(34836).setConfidence(1.0);
+  EXPECT_FALSE(manager.hasAnyLightChanged(version));
+  manager.getTrafficLight(34836).setConfidence(0.5);
+  EXPECT_TRUE(manager.hasAnyLightChanged(version));
+  version = manager.getVersion();
+  manager.getTrafficLight(34836).clear();
+  EXPECT_TRUE(manager.hasAnyLightChanged(version));
+  version = manager.getVersion();
+  manager.getTrafficLight(34836).clear();
+  EXPECT_FALSE(manager.hasAnyLightChanged(version));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,105 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <traffic_simulator/utils/entity_broadphase.hpp>
+#include <vector>
+
+auto makeStatuses() -> traffic_simulator::EntityBroadphase::Statuses
+{
+  traffic_simulator::EntityBroadphase::Statuses statuses;
+  const auto add = [&](const std::string & name, const double x, const double y) {
+    traffic_simulator::EntityStatus status;
+    status.name = name;
+    status.pose.position.x = x;
+    status.pose.position.y = y;
+    status.bounding_box.dimensions.x = 4.0;
+    status.bounding_box.dimensions.y = 2.0;
+    status.bounding_box.dimensions.z = 1.5;
+    status.lanelet_pose_valid = false;
+    statuses.emplace(name, traffic_simulator::CanonicalizedEntityStatus(status, nullptr));
+  };
+  add("origin", 0.0, 0.0);
+  add("near", 8.0, 0.0);
+  add("far", 100.0, 0.0);
+  add("negative", -25.0, -25.0);
+  return statuses;
+}
+
+auto sorted(std::vector<std::string> names) -> std::vector<std::string>
+{
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+TEST(EntityBroadphase, getEntityNamesInRange)
+{
+  const traffic_simulator::EntityBroadphase broadphase(makeStatuses());
+  geometry_msgs::msg::Point center;
+  EXPECT_EQ(
+    sorted(broadphase.getEntityNamesInRange(center, 1.0)), std::vector<std::string>({"origin"}));
+  EXPECT_EQ(
+    sorted(broadphase.getEntityNamesInRange(center, 7.0)),
+    std::vector<std::string>({"near", "origin"}));
+  center.x = -24.0;
+  center.y = -24.0;
+  EXPECT_EQ(
+    sorted(broadphase.getEntityNamesInRange(center, 0.5)),
+    std::vector<std::string>({"negative"}));
+  center.x = 50.0;
+  center.y = 0.0;
+  EXPECT_TRUE(broadphase.getEntityNamesInRange(center, 10.0).empty());
+}
+
+/// @note A range larger than the whole grid falls back to checking every entity.
+TEST(EntityBroadphase, getEntityNamesInLargeRange)
+{
+  const traffic_simulator::EntityBroadphase broadphase(makeStatuses());
+  EXPECT_EQ(
+    sorted(broadphase.getEntityNamesInRange(geometry_msgs::msg::Point(), 1000.0)),
+    std::vector<std::string>({"far", "near", "negative", "origin"}));
+}
+
+TEST(EntityBroadphase, getEntityNamesOnLanelets)
+{
+  const traffic_simulator::EntityBroadphase broadphase(makeStatuses());
+  EXPECT_TRUE(broadphase.getEntityNamesOnLanelets({34513, 34510}).empty());
+}
+
+TEST(EntityBroadphase, BoundingBox2D)
+{
+  geometry_msgs::msg::Pose pose;
+  traffic_simulator_msgs::msg::BoundingBox bounding_box;
+  bounding_box.center.x = 5.0;
+  bounding_box.dimensions.x = 2.0;
+  bounding_box.dimensions.y = 2.0;
+  const traffic_simulator::BoundingBox2D box(pose, bounding_box);
+  EXPECT_DOUBLE_EQ(box.min_x, 0.0);
+  EXPECT_DOUBLE_EQ(box.max_x, 6.0);
+  EXPECT_DOUBLE_EQ(box.min_y, -1.0);
+  EXPECT_DOUBLE_EQ(box.max_y, 1.0);
+  geometry_msgs::msg::Point center;
+  center.x = 7.5;
+  EXPECT_FALSE(box.intersects(traffic_simulator::BoundingBox2D(center, 1.0)));
+  EXPECT_TRUE(box.intersects(traffic_simulator::BoundingBox2D(center, 1.5)));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
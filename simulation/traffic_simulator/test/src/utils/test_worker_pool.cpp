@@ -0,0 +1,60 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/utils/worker_pool.hpp>
+#include <vector>
+
+TEST(WorkerPool, RunEveryIndexOnce)
+{
+  traffic_simulator::WorkerPool worker_pool(4);
+  EXPECT_EQ(worker_pool.threadCount(), 4U);
+  for (std::size_t size = 0; size < 100; ++size) {
+    std::vector<int> counts(size, 0);
+    worker_pool.run(size, [&](const std::size_t index) { ++counts[index]; });
+    EXPECT_EQ(counts, std::vector<int>(size, 1));
+  }
+}
+
+TEST(WorkerPool, RethrowExceptionOfSmallestIndex)
+{
+  traffic_simulator::WorkerPool worker_pool(4);
+  try {
+    worker_pool.run(100, [](const std::size_t index) {
+      if (index % 10 == 3) {
+        throw std::runtime_error(std::to_string(index));
+      }
+    });
+    FAIL();
+  } catch (const std::runtime_error & error) {
+    EXPECT_STREQ(error.what(), "3");
+  }
+}
+
+TEST(WorkerPool, SingleThread)
+{
+  traffic_simulator::WorkerPool worker_pool(1);
+  std::size_t count = 0;
+  worker_pool.run(10, [&](const std::size_t) { ++count; });
+  EXPECT_EQ(count, 10U);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}